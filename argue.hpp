@@ -23,28 +23,78 @@ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#if defined(__unix__) || defined(__APPLE__)
+  #define ARGUE_POSIX
+#endif
+
 #ifdef ARGUE_IMPLEMENTATION
   // Implementation-specific includes are put here
   //  so that they can be easily seen.
-  #include <charconv> // int64_t std::from_chars
+  #include <algorithm> // std::sort std::unique
+  #include <charconv>  // int64_t std::from_chars std::errc
+  #include <chrono>    // std::chrono::steady_clock
+  #include <cstring>   // std::memcpy
+  #include <exception> // std::exception_ptr std::rethrow_exception
+  #include <fstream>   // std::ifstream
+  #include <thread>    // std::thread
+  #include <unordered_set> // std::unordered_set
+
+  #ifdef ARGUE_POSIX
+    #include <cerrno>      // errno EINTR
+    #include <fcntl.h>     // fcntl F_ADD_SEALS O_CREAT O_NONBLOCK
+    #include <poll.h>      // poll
+    #include <sys/mman.h>  // mmap memfd_create shm_open
+    #include <sys/socket.h> // socket send recv
+    #include <sys/stat.h>  // fstat lstat
+    #include <sys/time.h>  // timeval
+    #include <sys/uio.h>   // writev
+    #include <sys/un.h>    // sockaddr_un
+    #include <unistd.h>    // write close unlink ftruncate
+    extern "C" char** environ; // Not declared by every unistd.h
+  #elif defined(_WIN32)
+    #include <stdlib.h>    // _get_environ
+  #endif
+
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ARGUE_SSE2
+    #include <emmintrin.h>
+  #endif
 #endif // ARGUE_IMPLEMENTATION
 
 #ifndef _ARGUE_HPP
 #define _ARGUE_HPP
 
+#include <atomic> // std::atomic
 #include <cinttypes>
+#include <cstdio> // FILE
+#include <functional> // std::function
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex std::recursive_mutex
 #include <stack>
 #include <string>
 #include <string_view>
-#include <utility> // std::forward
+#include <type_traits> // std::is_constant_evaluated
+#include <unordered_map> // std::unordered_map
+#include <utility> // std::forward std::exchange
 #include <vector>
 
+#ifdef ARGUE_POSIX
+  #include <list> // std::list
+#endif // ARGUE_POSIX
+
 #define ARGUE_DELETE_MOVE_COPY(className)            \
     className(const className&) = delete;            \
     className(className&&) = delete;                 \
     className& operator=(const className&) = delete; \
     className& operator=(className&&) = delete;      \
 
+// Only allows move construction, the moved-to object takes the place of the moved-from one
+#define ARGUE_RELOCATABLE(className)                 \
+    className(const className&) = delete;            \
+    className(className&&) = default;                \
+    className& operator=(const className&) = delete; \
+    className& operator=(className&&) = delete;      \
+
 #define ARGUE_UNUSED(var) \
     ((void)var)
 
@@ -62,7 +112,114 @@ namespace Argue
     constexpr std::string_view SPACE_CHARS = " \f\n\r\t\v";
     constexpr bool IsSpace(char ch)
     {
-        return SPACE_CHARS.find(ch) != std::string_view::npos;
+        // Same as searching SPACE_CHARS, '\t' '\n' '\v' '\f' '\r' are contiguous
+        return ch == ' ' || (ch >= '\t' && ch <= '\r');
+    }
+
+    // Returns the index of the first space character at or after `pos`, or npos.
+    // Same as `text.find_first_of(SPACE_CHARS, pos)` but scans multiple bytes at a time.
+    size_t FindSpace(std::string_view text, size_t pos=0);
+
+    // Returns true if text only contains ASCII characters, scanning multiple bytes at a time.
+    bool IsAscii(std::string_view text);
+
+    // Code points which take up no column, mostly combining marks (sorted, inclusive)
+    constexpr char32_t ZERO_WIDTH_RANGES[][2] = {
+        { 0x0300, 0x036F }, { 0x0483, 0x0489 }, { 0x0591, 0x05BD }, { 0x05BF, 0x05BF },
+        { 0x05C1, 0x05C2 }, { 0x05C4, 0x05C5 }, { 0x05C7, 0x05C7 }, { 0x0610, 0x061A },
+        { 0x064B, 0x065F }, { 0x0670, 0x0670 }, { 0x06D6, 0x06DC }, { 0x06DF, 0x06E4 },
+        { 0x06E7, 0x06E8 }, { 0x06EA, 0x06ED }, { 0x0900, 0x0902 }, { 0x093A, 0x093A },
+        { 0x093C, 0x093C }, { 0x0941, 0x0948 }, { 0x094D, 0x094D }, { 0x0951, 0x0957 },
+        { 0x0E31, 0x0E31 }, { 0x0E34, 0x0E3A }, { 0x0E47, 0x0E4E }, { 0x1160, 0x11FF },
+        { 0x1AB0, 0x1AFF }, { 0x1DC0, 0x1DFF }, { 0x200B, 0x200F }, { 0x202A, 0x202E },
+        { 0x2060, 0x2064 }, { 0x20D0, 0x20FF }, { 0x302A, 0x302D }, { 0x3099, 0x309A },
+        { 0xFE00, 0xFE0F }, { 0xFE20, 0xFE2F }, { 0xFEFF, 0xFEFF }, { 0xE0100, 0xE01EF },
+    };
+
+    // East Asian Wide and Fullwidth code points, they take up 2 columns (sorted, inclusive)
+    constexpr char32_t WIDE_RANGES[][2] = {
+        { 0x1100, 0x115F }, { 0x231A, 0x231B }, { 0x2329, 0x232A }, { 0x23E9, 0x23EC },
+        { 0x23F0, 0x23F0 }, { 0x23F3, 0x23F3 }, { 0x25FD, 0x25FE }, { 0x2614, 0x2615 },
+        { 0x2648, 0x2653 }, { 0x267F, 0x267F }, { 0x2693, 0x2693 }, { 0x26A1, 0x26A1 },
+        { 0x26AA, 0x26AB }, { 0x26BD, 0x26BE }, { 0x26C4, 0x26C5 }, { 0x26CE, 0x26CE },
+        { 0x26D4, 0x26D4 }, { 0x26EA, 0x26EA }, { 0x26F2, 0x26F3 }, { 0x26F5, 0x26F5 },
+        { 0x26FA, 0x26FA }, { 0x26FD, 0x26FD }, { 0x2705, 0x2705 }, { 0x270A, 0x270B },
+        { 0x2728, 0x2728 }, { 0x274C, 0x274C }, { 0x274E, 0x274E }, { 0x2753, 0x2755 },
+        { 0x2757, 0x2757 }, { 0x2795, 0x2797 }, { 0x27B0, 0x27B0 }, { 0x27BF, 0x27BF },
+        { 0x2B1B, 0x2B1C }, { 0x2B50, 0x2B50 }, { 0x2B55, 0x2B55 }, { 0x2E80, 0x3029 },
+        { 0x302E, 0x303E }, { 0x3041, 0x3098 }, { 0x309B, 0x33FF }, { 0x3400, 0x4DBF },
+        { 0x4E00, 0x9FFF }, { 0xA000, 0xA4CF }, { 0xA960, 0xA97F }, { 0xAC00, 0xD7A3 },
+        { 0xF900, 0xFAFF }, { 0xFE10, 0xFE19 }, { 0xFE30, 0xFE6F }, { 0xFF00, 0xFF60 },
+        { 0xFFE0, 0xFFE6 }, { 0x16FE0, 0x16FE4 }, { 0x17000, 0x18CFF }, { 0x1B000, 0x1B2FF },
+        { 0x1F004, 0x1F004 }, { 0x1F0CF, 0x1F0CF }, { 0x1F18E, 0x1F18E }, { 0x1F191, 0x1F19A },
+        { 0x1F200, 0x1F202 }, { 0x1F210, 0x1F23B }, { 0x1F240, 0x1F248 }, { 0x1F250, 0x1F251 },
+        { 0x1F260, 0x1F265 }, { 0x1F300, 0x1F64F }, { 0x1F680, 0x1F6FF }, { 0x1F7E0, 0x1F7EB },
+        { 0x1F90C, 0x1F9FF }, { 0x1FA70, 0x1FAFF }, { 0x20000, 0x2FFFD }, { 0x30000, 0x3FFFD },
+    };
+
+    template<size_t N>
+    constexpr bool IsInRanges(char32_t codePoint, const char32_t (&ranges)[N][2])
+    {
+        size_t lo = 0, hi = N;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (codePoint < ranges[mid][0]) {
+                hi = mid;
+            } else if (codePoint > ranges[mid][1]) {
+                lo = mid + 1;
+            } else return true;
+        }
+        return false;
+    }
+
+    // Returns the number of columns a terminal uses to display the code point:
+    //  0 for combining marks, 2 for East Asian Wide and Fullwidth characters, 1 otherwise.
+    constexpr size_t CodePointWidth(char32_t codePoint)
+    {
+        if (codePoint < 0x0300) return 1;
+        if (IsInRanges(codePoint, ZERO_WIDTH_RANGES)) return 0;
+        if (IsInRanges(codePoint, WIDE_RANGES)) return 2;
+        return 1;
+    }
+
+    /**
+     * Returns the number of columns a terminal uses to display UTF-8 encoded text.
+     * Each byte of an invalid sequence takes up 1 column, so the width is never
+     * greater than the length of the text, and the width of ASCII text is its length.
+     */
+    constexpr size_t DisplayWidth(std::string_view text)
+    {
+        if (!std::is_constant_evaluated() && IsAscii(text))
+            return text.length();
+
+        size_t width = 0;
+        for (size_t i = 0; i < text.length();) {
+            uint8_t lead = static_cast<uint8_t>(text[i]);
+            size_t length =
+                lead < 0x80 ? 1 :
+                (lead >= 0xC2 && lead <= 0xDF) ? 2 :
+                (lead >= 0xE0 && lead <= 0xEF) ? 3 :
+                (lead >= 0xF0 && lead <= 0xF4) ? 4 : 0;
+
+            char32_t codePoint = lead & (0x7F >> length);
+            for (size_t j = 1; j < length; ++j) {
+                uint8_t next = i+j < text.length() ? static_cast<uint8_t>(text[i+j]) : 0;
+                if ((next & 0xC0) != 0x80) {
+                    length = 0;
+                    break;
+                }
+                codePoint = (codePoint << 6) | (next & 0x3F);
+            }
+
+            if (length <= 1) {
+                ++width;
+                ++i;
+            } else {
+                width += CodePointWidth(codePoint);
+                i += length;
+            }
+        }
+        return width;
     }
 
     class ITextBuilder
@@ -82,20 +239,146 @@ namespace Argue
         virtual std::string Build() = 0;
     };
 
-    class TextBuilder final :
-        public ITextBuilder
+    /**
+     * The word wrapping and indentation of WrappingTextBuilder and StaticTextBuilder,
+     * so that text is laid out the same at runtime and in constant expressions.
+     * Builder keeps the current line and provides:
+     *   bool HasLine() const;                // true once the current line was appended to
+     *   char GetLineBack() const;            // The last character of the current line
+     *   void AppendIndent();                 // Appends one indentation as is
+     *   void AppendWords(std::string_view);  // Appends text writing space characters as ' '
+     *   void NewLine();                      // Completes the current line and calls ::EndLine()
+     */
+    template<typename Builder>
+    class TextWrapper
     {
     public:
-        TextBuilder(
-                std::string_view indent="  ",
-                bool indentOnWrap=true,
-                size_t maxParagraphWidth=80) :
-            m_Indent(indent),
+        constexpr TextWrapper(bool indentOnWrap, size_t maxParagraphWidth) :
             m_IndentOnWrap(indentOnWrap),
             m_MaxParagraphWidth(maxParagraphWidth)
         {}
 
-        virtual ~TextBuilder() = default;
+        constexpr void PutText(std::string_view text)
+        {
+            std::string_view::size_type newLineIdx;
+            while ((newLineIdx = text.find('\n')) != std::string_view::npos) {
+                PutLine(text.substr(0, newLineIdx));
+                text.remove_prefix(newLineIdx+1);
+                Self().NewLine();
+            }
+            PutLine(text);
+        }
+
+        constexpr void Indent() { ++m_IndentationLevel; }
+        constexpr void DeIndent()
+        {
+            if (m_IndentationLevel > 0)
+                --m_IndentationLevel;
+        }
+
+    protected:
+        // Called by Builder::NewLine() once the current line was completed
+        constexpr void EndLine() { m_LineWidth = 0; }
+        // Discards the indentation and the width of the current line
+        constexpr void ResetWrapping()
+        {
+            m_IndentationLevel = 0;
+            m_LineWidth = 0;
+        }
+
+    private:
+        constexpr Builder& Self() { return static_cast<Builder&>(*this); }
+
+        // Call this if text does not contain new lines
+        constexpr void PutLine(std::string_view text)
+        {
+            while (true) {
+                bool hasWrapped = Self().HasLine()         &&
+                    m_LineWidth >= m_MaxParagraphWidth     &&
+                    (
+                        IsSpace(Self().GetLineBack()) ||
+                        (!text.empty() && IsSpace(text[0]))
+                    );
+
+                if (hasWrapped) Self().NewLine();
+                PutLineIndent(hasWrapped);
+
+                // The space which caused the wrap is dropped
+                if (hasWrapped && !text.empty() && IsSpace(text[0])) {
+                    text.remove_prefix(1);
+                    continue;
+                }
+
+                // Copy all words which start before the line is full in one go,
+                //  up to and including the first space past the available width.
+                // Text is never wider than its length, so no word is copied past a wrap point.
+                size_t availableWidth = m_LineWidth < m_MaxParagraphWidth
+                    ? m_MaxParagraphWidth - m_LineWidth
+                    : 1;
+
+                std::string_view::size_type nextWordIdx = std::string_view::npos;
+                if (std::is_constant_evaluated()) {
+                    for (size_t i = availableWidth-1; i < text.length(); ++i) {
+                        if (IsSpace(text[i])) {
+                            nextWordIdx = i;
+                            break;
+                        }
+                    }
+                } else {
+                    nextWordIdx = FindSpace(text, availableWidth-1);
+                }
+
+                if (nextWordIdx == std::string_view::npos) {
+                    PutWords(text);
+                    break;
+                }
+
+                PutWords(text.substr(0, nextWordIdx+1));
+                text.remove_prefix(nextWordIdx+1);
+            }
+        }
+
+        constexpr void PutLineIndent(bool hasWrapped)
+        {
+            if (!Self().HasLine()) {
+                if (hasWrapped && m_IndentOnWrap)
+                    Self().AppendIndent();
+
+                for (size_t i = 0; i < m_IndentationLevel; ++i)
+                    Self().AppendIndent();
+            }
+        }
+
+        constexpr void PutWords(std::string_view words)
+        {
+            Self().AppendWords(words);
+            m_LineWidth += DisplayWidth(words);
+        }
+
+    private:
+        size_t m_IndentationLevel = 0;
+        // Display width of the current line, indentation excluded
+        size_t m_LineWidth = 0;
+
+        bool m_IndentOnWrap;
+        size_t m_MaxParagraphWidth;
+    };
+
+    // Implements word wrapping and indentation, completed lines are passed to ::WriteLine()
+    class WrappingTextBuilder :
+        public ITextBuilder,
+        private TextWrapper<WrappingTextBuilder>
+    {
+    public:
+        WrappingTextBuilder(
+                std::string_view indent,
+                bool indentOnWrap,
+                size_t maxParagraphWidth) :
+            TextWrapper(indentOnWrap, maxParagraphWidth),
+            m_Indent(indent)
+        {}
+
+        virtual ~WrappingTextBuilder() = default;
 
         void PutText(std::string_view text) override;
 
@@ -105,36 +388,445 @@ namespace Argue
         void Indent() override;
         void DeIndent() override;
 
+        // Discards all text and indentation, allocated memory is kept
+        virtual void Reset();
+
+    protected:
+        // Called with each completed line, trailing spaces are removed.
+        // The line may be empty, lines are separated by a single new line.
+        virtual void WriteLine(std::string_view line) = 0;
+        // Called after the current line was completed by ::Spacer(),
+        //  the text should end with an empty line unless it already does.
+        virtual void WriteSpacer() = 0;
+
+        // The line being wrapped, it has not been passed to ::WriteLine() yet
+        const std::string& GetCurrentLine() const { return m_CurrentLine; }
+
+    private:
+        friend class TextWrapper<WrappingTextBuilder>;
+
+        bool HasLine() const { return !m_CurrentLine.empty(); }
+        char GetLineBack() const { return m_CurrentLine.back(); }
+        void AppendIndent() { m_CurrentLine += m_Indent; }
+        void AppendWords(std::string_view words);
+
+    private:
+        std::string m_CurrentLine = "";
+        std::string m_Indent;
+    };
+
+    class TextBuilder final :
+        public WrappingTextBuilder
+    {
+    public:
+        TextBuilder(
+                std::string_view indent="  ",
+                bool indentOnWrap=true,
+                size_t maxParagraphWidth=80) :
+            WrappingTextBuilder(indent, indentOnWrap, maxParagraphWidth)
+        {}
+
+        virtual ~TextBuilder() = default;
+
         /**
          * The built text will start with a non-space character
          * and end with a new line preceded by a non-space character.
          * Space characters are defined by the `::IsSpace()` function
          * and `SPACE_CHARS` variable.
+         * The returned string takes over the memory of this builder,
+         * which can be reserved beforehand with ::Reserve().
          */
         std::string Build() override;
-    
+        void Reset() override;
+
+        // Reserves memory for a built text of `size` bytes, see CountingTextBuilder
+        void Reserve(size_t size) { m_Text.reserve(size); }
+
     protected:
-        // Call this if text does not contain new lines
-        void PutLine(std::string_view text);
-        void PutLineIndent(bool hasWrapped);
+        void WriteLine(std::string_view line) override;
+        void WriteSpacer() override;
 
     private:
         std::string m_Text = "";
+    };
 
-        size_t m_IndentationLevel = 0;
-        std::string m_CurrentLine = "";
-        size_t m_CurrentLineIndentLength = 0;
+    /**
+     * Passes text to ::Put() as soon as lines are completed.
+     * Trailing empty lines are held back until more text follows, so that
+     * the text put is the same as the one returned by TextBuilder::Build().
+     */
+    class StreamingTextBuilder :
+        public WrappingTextBuilder
+    {
+    public:
+        using WrappingTextBuilder::WrappingTextBuilder;
 
-        std::string m_Indent;
-        bool m_IndentOnWrap;
-        size_t m_MaxParagraphWidth;
+        virtual ~StreamingTextBuilder() = default;
+
+        // Puts the remaining text and calls ::Finish().
+        // The returned string is always empty, the text was passed to ::Put().
+        std::string Build() override;
+        void Reset() override;
+
+    protected:
+        void WriteLine(std::string_view line) override;
+        void WriteSpacer() override;
+
+        virtual void Put(std::string_view text) = 0;
+        // Called by ::Build() once all text was put
+        virtual void Finish() {}
+
+    private:
+        void PutPendingNewLines();
+
+    private:
+        bool m_HasText = false;
+        size_t m_PendingNewLines = 0;
+    };
+
+    /**
+     * Wraps text exactly like TextBuilder, but writes each completed line to a file
+     * through a fixed size buffer instead of keeping the whole text in memory.
+     * Output is not guaranteed to be written until ::Build() is called.
+     */
+    class FileTextBuilder final :
+        public StreamingTextBuilder
+    {
+    public:
+        static constexpr size_t BUFFER_CAPACITY = 4096;
+
+        // `file` is not closed by this builder
+        FileTextBuilder(
+                FILE* file,
+                std::string_view indent="  ",
+                bool indentOnWrap=true,
+                size_t maxParagraphWidth=80) :
+            StreamingTextBuilder(indent, indentOnWrap, maxParagraphWidth),
+            m_File(file)
+        {}
+
+    #ifdef ARGUE_POSIX
+        // `fd` is not closed by this builder, writes go straight to it with writev
+        FileTextBuilder(
+                int fd,
+                std::string_view indent="  ",
+                bool indentOnWrap=true,
+                size_t maxParagraphWidth=80) :
+            StreamingTextBuilder(indent, indentOnWrap, maxParagraphWidth),
+            m_Fd(fd)
+        {}
+    #endif // ARGUE_POSIX
+
+        virtual ~FileTextBuilder() = default;
+
+        ARGUE_DELETE_MOVE_COPY(FileTextBuilder)
+
+        // Returns true if writing to the file failed at least once
+        bool HasError() const { return m_HasError; }
+
+        // Buffered text which was not written yet is discarded
+        void Reset() override;
+
+    protected:
+        void Put(std::string_view text) override;
+        // Writes the buffer and flushes the file
+        void Finish() override { Flush(); }
+
+    private:
+        // Writes the buffer followed by `data`
+        void Flush(std::string_view data="");
+
+    private:
+        FILE* m_File = nullptr;
+        int m_Fd = -1;
+        bool m_HasError = false;
+
+        size_t m_BufferSize = 0;
+        char m_Buffer[BUFFER_CAPACITY];
+    };
+
+    /**
+     * Counts the bytes TextBuilder::Build() would return without storing any text.
+     * It allows rendering into a TextBuilder with a single allocation:
+     *   CountingTextBuilder counter;
+     *   parser.WriteHelp(counter);
+     *   counter.Build();
+     *   TextBuilder help;
+     *   help.Reserve(counter.GetSize());
+     *   parser.WriteHelp(help);
+     *   std::string text = help.Build();
+     * Both builders must be constructed with the same arguments.
+     */
+    class CountingTextBuilder final :
+        public StreamingTextBuilder
+    {
+    public:
+        CountingTextBuilder(
+                std::string_view indent="  ",
+                bool indentOnWrap=true,
+                size_t maxParagraphWidth=80) :
+            StreamingTextBuilder(indent, indentOnWrap, maxParagraphWidth)
+        {}
+
+        virtual ~CountingTextBuilder() = default;
+
+        // Returns the size of the text counted until the last call to ::Build()
+        size_t GetSize() const { return m_Size; }
+
+        void Reset() override;
+
+    protected:
+        void Put(std::string_view text) override { m_Counted += text.length(); }
+        void Finish() override
+        {
+            m_Size = m_Counted;
+            m_Counted = 0;
+        }
+
+    private:
+        size_t m_Counted = 0;
+        size_t m_Size = 0;
+    };
+
+    /**
+     * Maps names to indices, names are looked up in time proportional to their length.
+     * Names which share a prefix share the nodes of that prefix (radix tree).
+     */
+    class NameTrie
+    {
+    public:
+        static constexpr size_t NPOS = SIZE_MAX;
+        static constexpr size_t AMBIGUOUS = SIZE_MAX-1;
+
+        struct Match
+        {
+            std::string Name;
+            size_t Index;
+        };
+
+    public:
+        void Clear()
+        {
+            m_Nodes.clear();
+            m_Labels.clear();
+        }
+        bool IsEmpty() const { return m_Nodes.empty(); }
+
+        // Reserves memory for `count` names with a total length of `length` bytes
+        void Reserve(size_t count, size_t length)
+        {
+            // A name adds at most a leaf and the node which splits its parent's label
+            m_Nodes.reserve(2*count + 1);
+            m_Labels.reserve(length);
+        }
+
+        // Returns false if `name` was already inserted, its index is left unchanged.
+        bool Insert(std::string_view name, size_t index);
+
+        // Returns the index of `name`, or NPOS if it was not inserted.
+        size_t Find(std::string_view name) const;
+        /**
+         * Returns the index of `name` if it was inserted, otherwise the index shared by all names
+         * starting with `name`. Returns AMBIGUOUS if their indices differ, or NPOS if there are none.
+         * `match` is set to the name which was found, the first one in lexicographic order.
+         */
+        size_t FindUnique(std::string_view name, std::string& match) const;
+        // Appends all names starting with `prefix` to `matches` in lexicographic order.
+        void FindWithPrefix(std::string_view prefix, std::vector<Match>& matches) const;
+        // Appends the indices of the non-empty names which `name` starts with, shortest first.
+        void FindPrefixesOf(std::string_view name, std::vector<size_t>& indices) const;
+        /**
+         * Appends the names with the smallest edit distance to `name` to `matches`
+         * if that distance is at most `maxDistance`, in lexicographic order.
+         * Names longer than 64 bytes are never matched.
+         */
+        void FindClosest(std::string_view name, size_t maxDistance, std::vector<Match>& matches) const;
+
+    private:
+        struct Node
+        {
+            // The part of the name between the parent and this node, within m_Labels
+            size_t LabelStart = 0;
+            size_t LabelLength = 0;
+            char FirstByte = '\0'; // The first byte of the label
+            size_t Index = NPOS;
+            // The index of all names from this node onwards, AMBIGUOUS if they differ
+            size_t SubtreeIndex = NPOS;
+            // Children are linked in order of the first byte of their label
+            size_t FirstChild = NPOS;
+            size_t NextSibling = NPOS;
+        };
+
+        std::string_view GetLabel(size_t node) const
+        {
+            return std::string_view(m_Labels).substr(m_Nodes[node].LabelStart, m_Nodes[node].LabelLength);
+        }
+
+        void CollectMatches(size_t node, std::string& name, std::vector<Match>& matches) const;
+
+    private:
+        std::vector<Node> m_Nodes;
+        std::string m_Labels;
+    };
+
+    // Guards the builds of every LazyValue.
+    // Builds only happen once per value and may nest (e.g. a hint built while building another),
+    //  so caches share a single recursive mutex instead of each holding its own.
+    inline std::recursive_mutex& GetCacheMutex()
+    {
+        static std::recursive_mutex mutex;
+        return mutex;
+    }
+
+    /**
+     * A value built on first use, e.g. a hint or an index of names.
+     * Threads may read it at the same time, only the first one builds it and later reads don't lock.
+     * It must not be cleared while it may be read, see IArgParser::OnSchemaChanged().
+     */
+    template<typename T>
+    class LazyValue
+    {
+    public:
+        LazyValue() = default;
+        LazyValue(LazyValue&& other) noexcept :
+            m_IsBuilt(other.m_IsBuilt.load()),
+            m_Value(std::move(other.m_Value))
+        {}
+
+        LazyValue(const LazyValue&) = delete;
+        LazyValue& operator=(const LazyValue&) = delete;
+        LazyValue& operator=(LazyValue&&) = delete;
+
+        // Calls `build` with the value to build if it was not built yet, it may hold a previous value
+        template<typename Build>
+        const T& Get(Build&& build) const
+        {
+            if (!m_IsBuilt.load(std::memory_order_acquire)) {
+                std::lock_guard<std::recursive_mutex> lock(GetCacheMutex());
+                if (!m_IsBuilt.load(std::memory_order_relaxed)) {
+                    build(m_Value);
+                    m_IsBuilt.store(true, std::memory_order_release);
+                }
+            }
+            return m_Value;
+        }
+
+        void Clear() { m_IsBuilt.store(false, std::memory_order_relaxed); }
+
+    private:
+        mutable std::atomic<bool> m_IsBuilt = false;
+        mutable T m_Value;
+    };
+
+    // Forward declarations
+    class ArgParser;
+    class IArgParser;
+    class IOption;
+    class IPositionalArgument;
+    class SchemaView;
+
+    // The state of IArgParser::Parse() between two words
+    struct ParseState
+    {
+        IArgParser* Parser = nullptr; // The innermost command parsing words
+        size_t PositionalIdx = 0;
+        bool IsParsingPositionals = false;
+    };
+
+    // Receives the value of an option or of a positional argument, see IOption::WriteValue()
+    class IValueWriter
+    {
+    public:
+        virtual ~IValueWriter() = default;
+
+        virtual void WriteBool(bool value) = 0;
+        virtual void WriteInt(int64_t value) = 0;
+        virtual void WriteString(std::string_view value) = 0;
+        virtual void WriteStrings(const std::vector<std::string>& values) = 0;
+    };
+
+    // Describes how a built-in option or positional argument parses, see IOption::WriteSchema()
+    struct SchemaEntry
+    {
+        enum class Kind : uint8_t
+        {
+            Flag,
+            Int,
+            String,
+            Choice,
+            Collection,
+            Argument,
+            VarArgument,
+        };
+
+        Kind Type = Kind::String;
+        // The default of flags and integers, or the index of the default choice
+        int64_t DefaultInt = 0;
+        std::string_view DefaultString;
+        const std::vector<std::string>* Choices = nullptr;
+    };
+
+    // Notified of the progress of IArgParser::Parse(), see IncrementalParser
+    class IParseObserver
+    {
+    public:
+        virtual ~IParseObserver() = default;
+
+        // Called after each word was parsed, the command's name included
+        virtual void OnWordParsed(const ParseState& state) = 0;
+        // Called when an option or a positional argument parsed successfully
+        virtual void OnOptionParsed(IOption& opt, std::string_view arg, bool isShort) = 0;
+        virtual void OnArgumentParsed(IPositionalArgument& arg, std::string_view value) = 0;
+        // Called when the observed parser is moved, `parser` is the new object
+        virtual void OnParserMoved(ArgParser& parser) { ARGUE_UNUSED(parser); }
+    };
+
+    // A binding cannot be moved/copied and must live as long as its parser.
+    // Its parser can be moved, the binding will then be resolved by the new object.
+    class IConfigBinding
+    {
+    public:
+        IConfigBinding(IArgParser& parser);
+        virtual ~IConfigBinding() = default;
+
+        ARGUE_DELETE_MOVE_COPY(IConfigBinding)
+
+    public:
+        // Called once by `parser` after it was used and parsed successfully.
+        virtual void Resolve(const IArgParser& parser) = 0;
     };
 
-    class IArgParser; // Forward declaration
+    // A source cannot be moved/copied and must live as long as its parser, see EnvBinding.
+    // Its parser can be moved, the source will then be resolved by the new object.
+    class IValueSource
+    {
+        friend class IArgParser;
+    public:
+        IValueSource(IArgParser& parser);
+        virtual ~IValueSource() = default;
+
+        ARGUE_DELETE_MOVE_COPY(IValueSource)
+
+    public:
+        // Called by `parser` after it was used and parsed its words, before checking that its options
+        //  have a value. Sources added first are resolved first, see IOption::ParseFallback().
+        // Returns false if a value is not valid, the parser's error is then set.
+        virtual bool Resolve(IArgParser& parser) = 0;
+
+    protected:
+        // The parser this source was added to, it follows the parser when it's moved
+        IArgParser& GetParser() const { return *m_Parser; }
+
+    private:
+        IArgParser* m_Parser;
+    };
 
-    // An option cannot be moved/copied and must live as long as its parser
+    // An option cannot be copied and must live as long as its parser.
+    // It can be moved (e.g. by a std::vector growing), its parser will refer to the new object.
     class IOption
     {
+        friend class IArgParser;
+        friend class IncrementalParser;
     public:
         IOption(IArgParser& parser,
                 std::string_view name,
@@ -144,7 +836,10 @@ namespace Argue
 
         virtual ~IOption() = default;
 
-        ARGUE_DELETE_MOVE_COPY(IOption)
+        IOption(IOption&& other) noexcept;
+        IOption(const IOption&) = delete;
+        IOption& operator=(const IOption&) = delete;
+        IOption& operator=(IOption&&) = delete;
 
         const std::string& GetName() const { return m_Name; }
 
@@ -157,7 +852,13 @@ namespace Argue
         bool HasDescription() const { return !m_Description.empty(); }
         const std::string& GetDescription() const { return m_Description; }
 
-        const IArgParser& GetParser() const { return m_Parser; }
+        // Adds another long name to this option, aliases follow the other names in hints
+        IOption& AddAlias(std::string_view alias);
+        const std::vector<std::string>& GetAliases() const { return m_Aliases; }
+
+        const IArgParser& GetParser() const { return *m_Parser; }
+        // The index of this option within IArgParser::GetOptions(), it's kept when either of them is moved
+        size_t GetHandle() const { return m_Handle; }
 
         operator bool() const { return HasValue(); }
 
@@ -168,23 +869,64 @@ namespace Argue
         // Returns true if parsing was successful.
         // Returning false does not mean that ::SetError was called.
         // If the parser has no error, the option was not recognized.
-        bool Parse(std::string_view arg, bool isShort)
+        bool Parse(std::string_view arg, bool isShort);
+
+        // Forgets that this option was parsed, see ::ResetValue()
+        void Reset()
         {
-            if (ParseArg(arg, isShort)) {
-                m_WasParsed = true;
-                return true;
-            }
-            return false;
+            m_WasParsed = false;
+            m_IsFallback = false;
+            ResetValue();
         }
 
+        /**
+         * Parses `value` with ::ParseValue() if this option was not parsed from the command line,
+         * e.g. the value of an environment variable. Sources only call it on options which were not parsed,
+         * so that they don't override each other, see IValueSource. The option then counts as parsed until
+         * it's parsed from the command line, which replaces the value, or its parser resolves its sources again.
+         * If `value` is not valid, the error is set by ::ParseValue() and sources prefix it with where the value comes from.
+         */
+        bool ParseFallback(std::string_view value);
+        // Returns true if the value was given by ::ParseFallback()
+        bool IsFallback() const { return m_IsFallback; }
+
     public:
         virtual bool HasDefaultValue() const { return false; }
         // Returns true if this option requires the MetaVar to have a value when parsing.
         virtual bool IsVarOptional() const { return false; }
 
+        // Writes the text returned by ::BuildHint(), followed by the aliases
         virtual void WriteHint(ITextBuilder& hint) const;
         virtual void WriteHelp(ITextBuilder& help) const;
 
+        // Names which may follow the parser's prefix, used to look this option up.
+        // They must only depend on the option's definition.
+        virtual std::vector<std::string> GetLongNames() const;
+        // Returns true if ::ParseArg() may accept words which start neither with the short name
+        //  nor with one of ::GetLongNames(). Such options are tried on every word which is not
+        //  parsed by looking names up, it must only depend on the option's definition.
+        // Other option types are assumed to, the built-in types return false. Overriding it to
+        //  return false spares words from being tried on the option.
+        virtual bool ParsesCustomWords() const { return true; }
+        // Appends the options whose value is also set when this one is parsed
+        virtual void AppendLinkedOptions(std::vector<IOption*>& options) const { ARGUE_UNUSED(options); }
+        // Appends values starting with `prefix` which may be given to this option.
+        virtual void CompleteValue(std::string_view prefix, std::vector<std::string>& candidates) const
+        {
+            ARGUE_UNUSED(prefix);
+            ARGUE_UNUSED(candidates);
+        }
+        // Writes the value returned by GetValue() with a single call, if it has one.
+        // Options which don't write anything are not present in encoded results, see EncodeParseResult()
+        virtual void WriteValue(IValueWriter& writer) const { ARGUE_UNUSED(writer); }
+        // Returns false if the option is not one of the built-in types, its parser then can't
+        //  be encoded into a schema image, see EncodeSchema()
+        virtual bool WriteSchema(SchemaEntry& entry) const
+        {
+            ARGUE_UNUSED(entry);
+            return false;
+        }
+
         // true if GetValue() will return a valid value.
         // MUST return true if ::WasParsed() returns true.
         // i.e. Parse was successful or a default exists
@@ -194,8 +936,21 @@ namespace Argue
         // And a dereference alias to that method
 
     protected:
+        // Builds the hint written by ::WriteHint(), it is only called once and then cached.
+        // The hint must only depend on the option's definition.
+        virtual std::string BuildHint() const;
+
         // See ::Parse()
         virtual bool ParseArg(std::string_view arg, bool isShort);
+        // Restores the value the option had before being parsed, if it's not ignored until then
+        virtual void ResetValue() {}
+        // Restores the value as it was after its first `parseCount` parses since it was reset.
+        // Returns false if it can't, it's then reset and parsed again, see IncrementalParser.
+        virtual bool RestoreValue(size_t parseCount)
+        {
+            ARGUE_UNUSED(parseCount);
+            return false;
+        }
 
         // Implementing this method will allow to use the default behaviour of ::ParseArg()
         // i.e. --longName=VALUE, -shortVALUE
@@ -209,19 +964,32 @@ namespace Argue
         bool SetError(std::string&& errorMessage);
 
         // Default name parsing behaviour, use this within ::Parse()
+        // The longest of the name and aliases which `arg` starts with is consumed.
         bool ConsumeName(std::string_view& arg, bool isShort);
+        // Returns true if `name` is the name or an alias of this option
+        bool IsLongName(std::string_view name) const;
 
     private:
         bool m_WasParsed = false;
-        IArgParser& m_Parser;
+        bool m_IsFallback = false;
+        IArgParser* m_Parser;
+        size_t m_Handle;
         std::string m_Name;
         std::string m_ShortName;
         std::string m_MetaVar;
         std::string m_Description;
+        std::vector<std::string> m_Aliases;
+
+        LazyValue<std::string> m_Hint;
     };
 
+    // A positional argument cannot be copied and must live as long as its parser.
+    // It can be moved, its parser will refer to the new object.
     class IPositionalArgument
     {
+        friend class IArgParser;
+        friend class IncrementalParser;
+
     public:
         // `metaVar` must have a length > 0 not counting spaces
         IPositionalArgument(
@@ -230,14 +998,19 @@ namespace Argue
                 std::string_view description);
         virtual ~IPositionalArgument() = default;
 
-        ARGUE_DELETE_MOVE_COPY(IPositionalArgument)
+        IPositionalArgument(IPositionalArgument&& other) noexcept;
+        IPositionalArgument(const IPositionalArgument&) = delete;
+        IPositionalArgument& operator=(const IPositionalArgument&) = delete;
+        IPositionalArgument& operator=(IPositionalArgument&&) = delete;
 
         const std::string& GetMetaVar() const { return m_MetaVar; }
 
         size_t HasDescription() const { return !m_Description.empty(); }
         const std::string& GetDescription() const { return m_Description; }
 
-        const IArgParser& GetParser() const { return m_Parser; }
+        const IArgParser& GetParser() const { return *m_Parser; }
+        // The index of this argument within IArgParser::GetArguments(), it's kept when either of them is moved
+        size_t GetHandle() const { return m_Handle; }
 
         operator bool() const { return HasValue(); }
 
@@ -248,13 +1021,13 @@ namespace Argue
         // Returns true if parsing was successful.
         // Returns false if ::SetError() was called.
         // A positional argument must be present at its position
-        bool Parse(std::string_view arg)
+        bool Parse(std::string_view arg);
+
+        // Forgets that this argument was parsed, see ::ResetValue()
+        void Reset()
         {
-            if (ParseArg(arg)) {
-                m_WasParsed = true;
-                return true;
-            }
-            return false;
+            m_WasParsed = false;
+            ResetValue();
         }
 
     public:
@@ -263,6 +1036,14 @@ namespace Argue
 
         virtual void WriteHint(ITextBuilder& hint) const;
         virtual void WriteHelp(ITextBuilder& help) const;
+        // See IOption::WriteValue()
+        virtual void WriteValue(IValueWriter& writer) const { ARGUE_UNUSED(writer); }
+        // See IOption::WriteSchema()
+        virtual bool WriteSchema(SchemaEntry& entry) const
+        {
+            ARGUE_UNUSED(entry);
+            return false;
+        }
 
         // true if GetValue() will return a valid value
         // MUST return true if ::WasParsed() returns true.
@@ -274,20 +1055,35 @@ namespace Argue
 
     protected:
         virtual bool ParseArg(std::string_view arg) = 0;
+        // Restores the value the argument had before being parsed, if it's not ignored until then
+        virtual void ResetValue() {}
+        // See IOption::RestoreValue()
+        virtual bool RestoreValue(size_t parseCount)
+        {
+            ARGUE_UNUSED(parseCount);
+            return false;
+        }
 
         // Always returns false, this allows `return SetError(...)` in ::Parse functions.
         bool SetError(std::string&& errorMessage);
 
     private:
         bool m_WasParsed = false;
-        IArgParser& m_Parser;
+        IArgParser* m_Parser;
+        size_t m_Handle;
         std::string m_MetaVar;
         std::string m_Description;
     };
 
-    // A parser cannot be moved/copied and must live as long as its options/subparsers
+    // A parser cannot be copied and must live as long as its options/subparsers.
+    // It can be moved, its options/subparsers will refer to the new object. So do its sources,
+    //  bindings and HelpCommand, and the IncrementalParser of a root parser (e.g. within a LiveConfig).
+    // Its const methods may be called by several threads at once (e.g. ::WriteHelp()), caches which
+    //  they fill are built once. Parsing, moving and changing the schema require exclusive access.
     class IArgParser
     {
+        friend class IncrementalParser;
+        friend class TreeCommand;
     public:
         // `command` for a root parser is the program itself
         IArgParser(std::string_view command, std::string_view description) :
@@ -295,20 +1091,43 @@ namespace Argue
             m_Description(description)
         {}
 
-        virtual ~IArgParser() = default;
+        virtual ~IArgParser();
 
-        ARGUE_DELETE_MOVE_COPY(IArgParser)
+        IArgParser(IArgParser&& other) noexcept;
+        IArgParser(const IArgParser&) = delete;
+        IArgParser& operator=(const IArgParser&) = delete;
+        IArgParser& operator=(IArgParser&&) = delete;
 
         const std::string& GetName() const { return m_Name; }
 
         size_t HasDescription() const { return !m_Description.empty(); }
         const std::string& GetDescription() const { return m_Description; }
 
+        // Adds another name to this command within its parent, e.g. "remove|rm" in hints
+        IArgParser& AddAlias(std::string_view alias);
+        const std::vector<std::string>& GetAliases() const { return m_Aliases; }
+
         // The returned pointers are not null unless something terrible happened
         const std::vector<IOption*>& GetOptions() const { return m_Options; }
         const std::vector<IArgParser*>& GetSubCommands() const { return m_Commands; }
         const std::vector<IPositionalArgument*>& GetArguments() const { return m_Arguments; }
 
+        // Indices of subcommands by name and alias, built on first use and kept until the schema changes
+        const NameTrie& GetCommandNames() const;
+        // Indices of options by each of their ::GetLongNames(), see ::GetCommandNames()
+        const NameTrie& GetOptionNames() const;
+        // Indices of options by short name, see ::GetCommandNames()
+        const NameTrie& GetShortOptionNames() const;
+        // Index of the option whose short name is the single byte `shortName`.
+        // NameTrie::NPOS if there is none, NameTrie::AMBIGUOUS if longer short names start with it.
+        size_t FindShortOption(char shortName) const;
+        // Indices of the options which are tried on every word which is not parsed by looking names up:
+        //  those which parse custom words (see IOption::ParsesCustomWords()), and those which share a name
+        //  with an earlier option, which is the one found.
+        const std::vector<size_t>& GetCustomOptions() const;
+        // Indices of the subcommands which parse custom words, see ::ParsesCustomWords()
+        const std::vector<size_t>& GetCustomCommands() const;
+
         // Returns true if this command was used and there was no error.
         // Moreover, all direct children options to this command have a value.
         operator bool() const { return !HasError() && m_WasUsed; }
@@ -321,50 +1140,175 @@ namespace Argue
             return Parse(args);
         }
 
+        // Same as above, `args` starts with the name of this parser (e.g. words from a Tokenizer)
+        bool Parse(const std::vector<std::string_view>& args)
+        {
+            std::stack<std::string_view> stack;
+            for (size_t i = args.size(); i > 0; --i)
+                stack.push(args[i-1]);
+            return Parse(stack);
+        }
+
+        /**
+         * Returns the help message built by a TextBuilder constructed with the given arguments.
+         * The message is cached until the schema of this parser or of any of its subcommands changes,
+         * messages requested with different arguments are cached alongside it.
+         * Cached messages are found without locking, returned messages stay valid until the parser
+         * (or the one it was moved to) is destroyed, even if the schema changed since.
+         */
+        const std::string& GetHelp(
+                bool briefOptions=false,
+                bool briefSubcommands=true,
+                std::string_view indent="  ",
+                bool indentOnWrap=true,
+                size_t maxParagraphWidth=80) const;
+
     public:
         virtual void WriteHint(ITextBuilder& hint) const;
         virtual void WriteHelp(ITextBuilder& help, bool briefOptions=false, bool briefSubcommands=true) const;
 
         // If this returns false, either there was an error or the command did not match.
         virtual bool Parse(std::stack<std::string_view> args);
+        // Returns true if ::Parse() may accept words other than the name and aliases of this parser.
+        // Such subcommands are tried on every word which is not the name of a subcommand.
+        // Other parser types are assumed to, ArgParser and CommandParser return false.
+        virtual bool ParsesCustomWords() const { return true; }
 
         virtual const std::string& GetError() const = 0;
         // Always returns false, this allows `return SetError(...)` in ::Parse functions.
         virtual bool SetError(std::string&& errorMessage) = 0;
         virtual bool HasError() const = 0;
 
+        // Same as ::SetError(), the names within `names` closest to `unknown` are then suggested
+        //  at the end of the message.
+        bool SetErrorWithSuggestion(
+                std::string&& errorMessage,
+                const NameTrie& names,
+                std::string_view prefix,
+                std::string_view unknown);
+
         virtual const std::string& GetPrefix() const = 0;
         virtual const std::string& GetShortPrefix() const = 0;
         virtual bool HasShortPrefix() const { return !GetShortPrefix().empty(); }
 
+        // Returns the observer notified while parsing, if any
+        virtual IParseObserver* GetObserver() const { return nullptr; }
+
+        // Called with unknown options and unexpected positional arguments.
+        // Returns false if they are errors, which is the default behaviour.
+        virtual bool PassThrough(std::string_view arg)
+        {
+            ARGUE_UNUSED(arg);
+            return false;
+        }
+
     public: // The following methods are called by constructors
-        void AddOption(IOption& opt)
+        // The returned handle identifies the added object within this parser.
+        // It stays the same when the object is moved.
+        size_t AddOption(IOption& opt)
         {
             m_Options.emplace_back(&opt);
+            OnSchemaChanged();
+            return m_Options.size()-1;
         }
 
-        void AddCommand(IArgParser& cmd)
+        size_t AddCommand(IArgParser& cmd)
         {
             m_Commands.emplace_back(&cmd);
+            OnSchemaChanged();
+            return m_Commands.size()-1;
         }
 
-        void AddArgument(IPositionalArgument& arg)
+        size_t AddArgument(IPositionalArgument& arg)
         {
             m_Arguments.emplace_back(&arg);
+            OnSchemaChanged();
+            return m_Arguments.size()-1;
+        }
+
+        // Discards cached hints and help messages.
+        // Subcommands must also notify their parent.
+        virtual void OnSchemaChanged()
+        {
+            m_Hint.Clear();
+            ++m_HelpVersion;
+            m_CommandNames.Clear();
+            m_OptionNames.Clear();
+            m_ShortOptions.Clear();
+            m_ShortOptionNames.Clear();
+            m_CustomOptions.Clear();
+            m_CustomCommands.Clear();
+        }
+
+        void AddBinding(IConfigBinding& binding)
+        {
+            m_Bindings.emplace_back(&binding);
+        }
+
+        void AddSource(IValueSource& source)
+        {
+            m_Sources.emplace_back(&source);
         }
 
+    public: // The following methods are called by move constructors
+        void RelocateOption(size_t handle, IOption& opt)              { m_Options[handle] = &opt; }
+        void RelocateCommand(size_t handle, IArgParser& cmd)          { m_Commands[handle] = &cmd; }
+        void RelocateArgument(size_t handle, IPositionalArgument& arg) { m_Arguments[handle] = &arg; }
+
     protected:
         virtual bool CheckOptionsAndArguments();
 
+        // Called on each subcommand when this parser is moved.
+        virtual void RelocateParent(IArgParser& parent) { ARGUE_UNUSED(parent); }
+
+    private:
+        // Parses the remaining words of the command line from `state`, in which this parser is the innermost one
+        bool ParseWords(ParseState& state, std::stack<std::string_view>& args);
+        // Pops the word which was just parsed
+        void PopWord(const ParseState& state, std::stack<std::string_view>& args);
+        // Resolves sources, checks options and arguments, then resolves bindings on success.
+        bool Finalize();
+        // Resets the options given by sources, so that a parse which reuses them resolves them again
+        void ResetFallbacks();
+
     private:
         bool m_WasUsed = false;
 
         std::string m_Name;
         std::string m_Description;
+        std::vector<std::string> m_Aliases;
 
         std::vector<IOption*> m_Options;
         std::vector<IArgParser*> m_Commands;
         std::vector<IPositionalArgument*> m_Arguments;
+        std::vector<IConfigBinding*> m_Bindings;
+        std::vector<IValueSource*> m_Sources;
+
+        // Caches, see ::WriteHint() and ::GetHelp()
+        LazyValue<std::string> m_Hint; // Subcommands part of the hint
+
+        struct CachedHelp
+        {
+            bool BriefOptions;
+            bool BriefSubcommands;
+            std::string Indent;
+            bool IndentOnWrap;
+            size_t MaxParagraphWidth;
+            size_t Version; // The ::OnSchemaChanged() count it was built after
+            std::string Help;
+            CachedHelp* Next; // The message published before this one
+        };
+        // One message per set of arguments and version, the most recent first.
+        // Messages never change once published, they are freed with the parser.
+        mutable std::atomic<CachedHelp*> m_Help = nullptr;
+        size_t m_HelpVersion = 0;
+
+        LazyValue<NameTrie> m_CommandNames;
+        LazyValue<NameTrie> m_OptionNames;
+        LazyValue<std::vector<size_t>> m_ShortOptions; // One entry per byte, see ::FindShortOption()
+        LazyValue<NameTrie> m_ShortOptionNames;
+        LazyValue<std::vector<size_t>> m_CustomOptions;
+        LazyValue<std::vector<size_t>> m_CustomCommands;
     };
 
     class ArgParser final :
@@ -387,7 +1331,23 @@ namespace Argue
 
         ~ArgParser() = default;
 
-        ARGUE_DELETE_MOVE_COPY(ArgParser)
+        // The observer follows the parser, see IParseObserver::OnParserMoved()
+        ArgParser(ArgParser&& other) noexcept :
+            IArgParser(std::move(other)),
+            m_Prefix(std::move(other.m_Prefix)),
+            m_ShortPrefix(std::move(other.m_ShortPrefix)),
+            m_ErrorMessage(std::move(other.m_ErrorMessage)),
+            m_PassThrough(other.m_PassThrough),
+            m_Observer(other.m_Observer)
+        {
+            other.m_Observer = nullptr;
+            if (m_Observer != nullptr)
+                m_Observer->OnParserMoved(*this);
+        }
+
+        ArgParser(const ArgParser&) = delete;
+        ArgParser& operator=(const ArgParser&) = delete;
+        ArgParser& operator=(ArgParser&&) = delete;
 
     public:
         const std::string& GetError() const override { return m_ErrorMessage; }
@@ -397,14 +1357,43 @@ namespace Argue
             return false;
         }
         bool HasError() const override { return !m_ErrorMessage.empty(); }
+        // Forgets the error, e.g. before parsing again
+        void ClearError() { m_ErrorMessage.clear(); }
 
         const std::string& GetPrefix() const override { return m_Prefix; }
         const std::string& GetShortPrefix() const override { return m_ShortPrefix; }
+        bool ParsesCustomWords() const override { return false; }
+
+        /**
+         * Unknown options and unexpected positional arguments of this parser and its subcommands
+         * are appended to `unknownArgs` in their original order instead of being errors.
+         * Known options which reject their word (e.g. --times without its value) are still errors.
+         * Arguments are not copied, each view is a whole word of the parsed command line,
+         * e.g. its data() is one of `argv` and may be given to execv().
+         * `unknownArgs` must live until parsing is over, nullptr turns errors back on.
+         */
+        void SetPassThrough(std::vector<std::string_view>* unknownArgs) { m_PassThrough = unknownArgs; }
+
+        // The observer is notified while this parser and its subcommands parse, nullptr removes it
+        void SetObserver(IParseObserver* observer) { m_Observer = observer; }
+        IParseObserver* GetObserver() const override { return m_Observer; }
+
+        bool PassThrough(std::string_view arg) override
+        {
+            if (m_PassThrough == nullptr)
+                return false;
+            m_PassThrough->push_back(arg);
+            return true;
+        }
 
     private:
         std::string m_Prefix;
         std::string m_ShortPrefix;
         std::string m_ErrorMessage;
+        std::vector<std::string_view>* m_PassThrough = nullptr;
+        IParseObserver* m_Observer = nullptr;
+
+        friend class IncrementalParser;
     };
 
     class CommandParser final :
@@ -416,29 +1405,56 @@ namespace Argue
                 std::string_view command,
                 std::string_view description) :
             IArgParser(command, description),
-            m_Parent(parent)
+            m_Parent(&parent)
+        {
+            m_Handle = m_Parent->AddCommand(*this);
+        }
+
+        CommandParser(CommandParser&& other) noexcept :
+            IArgParser(std::move(other)),
+            m_Parent(other.m_Parent),
+            m_Handle(other.m_Handle)
         {
-            m_Parent.AddCommand(*this);
+            m_Parent->RelocateCommand(m_Handle, *this);
         }
 
         ~CommandParser() = default;
 
-        ARGUE_DELETE_MOVE_COPY(CommandParser)
+        CommandParser(const CommandParser&) = delete;
+        CommandParser& operator=(const CommandParser&) = delete;
+        CommandParser& operator=(CommandParser&&) = delete;
 
     public:
-        const std::string& GetError() const override { return m_Parent.GetError(); }
+        const std::string& GetError() const override { return m_Parent->GetError(); }
         bool SetError(std::string&& errorMessage) override
         {
-            m_Parent.SetError(std::forward<std::string>(errorMessage));
+            m_Parent->SetError(std::forward<std::string>(errorMessage));
             return false;
         }
-        bool HasError() const override { return m_Parent.HasError(); }
+        bool HasError() const override { return m_Parent->HasError(); }
+
+        bool PassThrough(std::string_view arg) override { return m_Parent->PassThrough(arg); }
+        IParseObserver* GetObserver() const override { return m_Parent->GetObserver(); }
+
+        // Follows the parent when it's moved
+        const IArgParser& GetParent() const { return *m_Parent; }
+
+        const std::string& GetPrefix() const override { return m_Parent->GetPrefix(); }
+        const std::string& GetShortPrefix() const override { return m_Parent->GetShortPrefix(); }
+        bool ParsesCustomWords() const override { return false; }
+
+        void OnSchemaChanged() override
+        {
+            IArgParser::OnSchemaChanged();
+            m_Parent->OnSchemaChanged();
+        }
 
-        const std::string& GetPrefix() const override { return m_Parent.GetPrefix(); }
-        const std::string& GetShortPrefix() const override { return m_Parent.GetShortPrefix(); }
+    protected:
+        void RelocateParent(IArgParser& parent) override { m_Parent = &parent; }
 
     private:
-        IArgParser& m_Parent;
+        IArgParser* m_Parent;
+        size_t m_Handle = 0;
     };
 
     class FlagOption :
@@ -452,21 +1468,31 @@ namespace Argue
                 std::string_view description,
                 bool defaultValue=false) :
             IOption(parser, name, shortName, "", description),
-            m_Default(defaultValue)
+            m_Default(defaultValue),
+            m_Initial(defaultValue)
         {
             SetValue(m_Default);
         }
 
         virtual ~FlagOption() = default;
 
-        ARGUE_DELETE_MOVE_COPY(FlagOption)
+        ARGUE_RELOCATABLE(FlagOption)
     
     public:
         bool HasDefaultValue() const override { return true; }
         bool IsVarOptional() const override { return true; }
+        bool ParsesCustomWords() const override { return false; }
 
-        void WriteHint(ITextBuilder& hint) const override;
         void WriteHelp(ITextBuilder& help) const override;
+        std::vector<std::string> GetLongNames() const override;
+        void WriteValue(IValueWriter& writer) const override { writer.WriteBool(GetValue()); }
+        bool WriteSchema(SchemaEntry& entry) const override
+        {
+            entry.Type = SchemaEntry::Kind::Flag;
+            // The value when not given, which may come from a group
+            entry.DefaultInt = m_Initial;
+            return true;
+        }
 
         bool GetDefaultValue() const { return m_Default; }
 
@@ -475,15 +1501,38 @@ namespace Argue
 
     public:
         virtual void SetValue(bool flag) { m_Value = flag; }
+        // Also sets the current value
+        void SetDefaultValue(bool flag)
+        {
+            m_Default = flag;
+            SetInitialValue(flag);
+        }
 
     protected:
+        std::string BuildHint() const override;
         bool ParseArg(std::string_view arg, bool isShort) override;
+        // Only used by ::ParseFallback(), e.g. "true" or "0"
+        bool ParseValue(std::string_view val) override;
+        // Linked flags are reset on their own, see FlagGroupOption::AppendLinkedOptions()
+        void ResetValue() override { FlagOption::SetValue(m_Initial); }
 
     private:
+        friend class FlagGroupOption;
+
+        // Sets the value this flag is reset to, flags of a group take the group's value
+        //  instead of their default
+        virtual void SetInitialValue(bool flag)
+        {
+            m_Initial = flag;
+            FlagOption::SetValue(flag);
+        }
+
         bool m_Value = false;
         bool m_Default = false;
+        bool m_Initial = false;
     };
 
+    // Flags within the group must not be moved while the group lives
     class FlagGroupOption final :
         public FlagOption
     {
@@ -499,7 +1548,7 @@ namespace Argue
             FlagOption(parser, name, shortName, description, defaultValue)
         {
             (m_Group.push_back(&static_cast<FlagOption&>(flagGroup)), ...);
-            SetValue(GetValue());
+            SetInitialValue(GetValue());
         }
 
         virtual ~FlagGroupOption() = default;
@@ -509,6 +1558,15 @@ namespace Argue
         const std::vector<FlagOption*>& GetGroup() const { return m_Group; }
 
     public:
+        // Includes the flags of nested groups
+        void AppendLinkedOptions(std::vector<IOption*>& options) const override
+        {
+            for (auto opt : m_Group) {
+                options.push_back(opt);
+                opt->AppendLinkedOptions(options);
+            }
+        }
+
         void SetValue(bool flag) override
         {
             FlagOption::SetValue(flag);
@@ -517,6 +1575,13 @@ namespace Argue
         }
 
     private:
+        void SetInitialValue(bool flag) override
+        {
+            FlagOption::SetInitialValue(flag);
+            for (auto opt : m_Group)
+                opt->SetInitialValue(flag);
+        }
+
         std::vector<FlagOption*> m_Group;
     };
 
@@ -540,11 +1605,25 @@ namespace Argue
 
         virtual ~IntOption() = default;
 
-        ARGUE_DELETE_MOVE_COPY(IntOption)
+        ARGUE_RELOCATABLE(IntOption)
 
     public:
         bool HasDefaultValue() const override { return m_HasDefault; }
         bool IsVarOptional() const override { return false; }
+        bool ParsesCustomWords() const override { return false; }
+
+        void WriteValue(IValueWriter& writer) const override
+        {
+            if (HasValue())
+                writer.WriteInt(GetValue());
+        }
+
+        bool WriteSchema(SchemaEntry& entry) const override
+        {
+            entry.Type = SchemaEntry::Kind::Int;
+            entry.DefaultInt = m_Default;
+            return true;
+        }
 
         int64_t GetDefaultValue() const { return m_Default; }
 
@@ -585,11 +1664,25 @@ namespace Argue
 
         virtual ~StrOption() = default;
 
-        ARGUE_DELETE_MOVE_COPY(StrOption)
+        ARGUE_RELOCATABLE(StrOption)
 
     public:
         bool HasDefaultValue() const override { return m_HasDefault; }
         bool IsVarOptional() const override { return false; }
+        bool ParsesCustomWords() const override { return false; }
+
+        void WriteValue(IValueWriter& writer) const override
+        {
+            if (HasValue())
+                writer.WriteString(GetValue());
+        }
+
+        bool WriteSchema(SchemaEntry& entry) const override
+        {
+            entry.Type = SchemaEntry::Kind::String;
+            entry.DefaultString = m_Default;
+            return true;
+        }
 
         const std::string& GetDefaultValue() const { return m_Default; }
 
@@ -649,15 +1742,30 @@ namespace Argue
 
         virtual ~ChoiceOption() = default;
 
-        ARGUE_DELETE_MOVE_COPY(ChoiceOption)
+        ARGUE_RELOCATABLE(ChoiceOption)
 
         std::string GetChoiceString() const;
+        const std::vector<std::string>& GetChoices() const { return m_Choices; }
 
     public:
         bool HasDefaultValue() const override { return m_HasDefault; }
         bool IsVarOptional() const override { return false; }
+        bool ParsesCustomWords() const override { return false; }
+
+        void CompleteValue(std::string_view prefix, std::vector<std::string>& candidates) const override;
+        void WriteValue(IValueWriter& writer) const override
+        {
+            if (HasValue())
+                writer.WriteString(GetValue());
+        }
 
-        void WriteHint(ITextBuilder& hint) const override;
+        bool WriteSchema(SchemaEntry& entry) const override
+        {
+            entry.Type = SchemaEntry::Kind::Choice;
+            entry.DefaultInt = static_cast<int64_t>(m_DefaultIdx);
+            entry.Choices = &m_Choices;
+            return true;
+        }
 
         std::string_view GetDefaultValue() const
         {
@@ -675,6 +1783,7 @@ namespace Argue
         }
 
     protected:
+        std::string BuildHint() const override;
         bool ParseValue(std::string_view val) override;
 
     private:
@@ -683,6 +1792,8 @@ namespace Argue
 
         bool m_HasDefault = false;
         size_t m_DefaultIdx = 0;
+
+        LazyValue<NameTrie> m_ChoiceNames; // Built on first completion
     };
 
     class CollectionOption final :
@@ -702,19 +1813,28 @@ namespace Argue
 
         virtual ~CollectionOption() = default;
 
-        ARGUE_DELETE_MOVE_COPY(CollectionOption)
+        ARGUE_RELOCATABLE(CollectionOption)
 
         bool AcceptsEmptyValues() const { return m_AcceptEmptyValues; }
 
     public:
         bool HasDefaultValue() const override { return true; }
         bool IsVarOptional() const override { return m_AcceptEmptyValues; }
+        bool ParsesCustomWords() const override { return false; }
+        void WriteValue(IValueWriter& writer) const override { writer.WriteStrings(GetValue()); }
+        bool WriteSchema(SchemaEntry& entry) const override
+        {
+            entry.Type = SchemaEntry::Kind::Collection;
+            return true;
+        }
 
         const std::vector<std::string>& operator*() const { return GetValue(); }
         const std::vector<std::string>& GetValue() const { return m_Value; }
 
     protected:
         bool ParseValue(std::string_view val) override;
+        void ResetValue() override { m_Value.clear(); }
+        bool RestoreValue(size_t parseCount) override;
 
     private:
         std::vector<std::string> m_Value;
@@ -740,12 +1860,25 @@ namespace Argue
 
         virtual ~StrArgument() = default;
 
-        ARGUE_DELETE_MOVE_COPY(StrArgument)
+        ARGUE_RELOCATABLE(StrArgument)
 
     public:
         bool HasDefaultValue() const override { return m_HasDefault; }
         bool IsVariadic() const override { return false; }
 
+        void WriteValue(IValueWriter& writer) const override
+        {
+            if (HasValue())
+                writer.WriteString(GetValue());
+        }
+
+        bool WriteSchema(SchemaEntry& entry) const override
+        {
+            entry.Type = SchemaEntry::Kind::Argument;
+            entry.DefaultString = m_Default;
+            return true;
+        }
+
         const std::string& GetDefaultValue() const { return m_Default; }
 
         const std::string& operator*() const { return GetValue(); }
@@ -772,28 +1905,157 @@ namespace Argue
         using IPositionalArgument::IPositionalArgument;
         virtual ~StrVarArgument() = default;
 
-        ARGUE_DELETE_MOVE_COPY(StrVarArgument)
+        ARGUE_RELOCATABLE(StrVarArgument)
 
     public:
         bool HasDefaultValue() const override { return true; }
         bool IsVariadic() const override { return true; }
+        void WriteValue(IValueWriter& writer) const override { writer.WriteStrings(GetValue()); }
+        bool WriteSchema(SchemaEntry& entry) const override
+        {
+            entry.Type = SchemaEntry::Kind::VarArgument;
+            return true;
+        }
 
         const std::vector<std::string>& operator*() const { return GetValue(); }
         const std::vector<std::string>& GetValue() const  { return m_Value; }
 
     protected:
         bool ParseArg(std::string_view arg) override;
+        void ResetValue() override { m_Value.clear(); }
+        bool RestoreValue(size_t parseCount) override;
 
     private:
         std::vector<std::string> m_Value;
     };
 
+    /**
+     * Writes the values of options and positional arguments into the fields of `config`
+     * once the parser has parsed successfully. Defaults are resolved at that time, so the
+     * struct can be read afterwards without going through each option's ::GetValue().
+     * Bindings of subcommands which were not used are not resolved.
+     */
+    template<typename Config>
+    class ConfigBinding final :
+        public IConfigBinding
+    {
+    public:
+        ConfigBinding(IArgParser& parser, Config& config) :
+            IConfigBinding(parser),
+            m_Config(config)
+        {}
+
+        virtual ~ConfigBinding() = default;
+
+        ARGUE_DELETE_MOVE_COPY(ConfigBinding)
+
+        // `value` can be any option or positional argument of the parser with a ::GetValue() method.
+        // It's looked up by its handle when the binding is resolved, so it may be moved.
+        template<typename Field, typename Value>
+        ConfigBinding& Bind(Field Config::* field, const Value& value)
+        {
+            static_assert(std::is_base_of_v<IOption, Value> || std::is_base_of_v<IPositionalArgument, Value>,
+                "Only options and positional arguments can be bound.");
+            m_Fields.emplace_back([field, handle = value.GetHandle()](Config& config, const IArgParser& parser) {
+                const Value* value;
+                if constexpr (std::is_base_of_v<IOption, Value>)
+                    value = static_cast<const Value*>(parser.GetOptions()[handle]);
+                else value = static_cast<const Value*>(parser.GetArguments()[handle]);
+                config.*field = static_cast<Field>(value->GetValue());
+            });
+            return *this;
+        }
+
+        const Config& operator*() const { return m_Config; }
+        const Config& GetConfig() const { return m_Config; }
+
+    public:
+        void Resolve(const IArgParser& parser) override
+        {
+            for (const auto& writeField : m_Fields)
+                writeField(m_Config, parser);
+        }
+
+    private:
+        Config& m_Config;
+        std::vector<std::function<void(Config&, const IArgParser&)>> m_Fields;
+    };
+
+    /**
+     * Environment variables indexed by name, so that each lookup does not scan all of them like getenv() does.
+     * Names and values are views of the indexed entries, variables which are set afterwards are not seen.
+     */
+    class Environment
+    {
+    public:
+        // Indexes the variables of this process
+        Environment();
+        // Indexes "NAME=value" entries, the array ends with nullptr. Entries must outlive the index.
+        explicit Environment(const char* const* entries);
+
+        ARGUE_DELETE_MOVE_COPY(Environment)
+
+        // Returns false if the variable is not set
+        bool Find(std::string_view name, std::string_view& value) const;
+        size_t GetSize() const { return m_Variables.size(); }
+
+    private:
+        void Index(const char* const* entries);
+
+    private:
+        std::unordered_map<std::string_view, std::string_view> m_Variables;
+    };
+
+    /**
+     * Gives the options of a parser which were not parsed the value of an environment variable,
+     * e.g. APP_JOBS for --jobs. Values are parsed by the options, see IOption::ParseFallback(), so
+     * the command line comes first, then the environment, then defaults. Empty variables are ignored.
+     * Options of subcommands are bound by a binding of their command, which is only resolved if it was used.
+     */
+    class EnvBinding final :
+        public IValueSource
+    {
+    public:
+        // `env` must live as long as this binding
+        EnvBinding(IArgParser& parser, const Environment& env) :
+            IValueSource(parser),
+            m_Env(env)
+        {}
+
+        virtual ~EnvBinding() = default;
+
+        ARGUE_DELETE_MOVE_COPY(EnvBinding)
+
+        // `opt` must be an option of the parser, it's looked up by its handle so it may be moved
+        EnvBinding& Bind(const IOption& opt, std::string_view variable)
+        {
+            m_Variables.push_back({ opt.GetHandle(), std::string(variable) });
+            return *this;
+        }
+
+        // Binds each option of the parser to `prefix` followed by its name in uppercase,
+        //  characters other than letters and digits are replaced by '_' (e.g. APP_DRY_RUN for --dry-run)
+        EnvBinding& BindAll(std::string_view prefix);
+
+    public:
+        bool Resolve(IArgParser& parser) override;
+
+    private:
+        struct Variable
+        {
+            size_t Option; // See IOption::GetHandle()
+            std::string Name;
+        };
+
+        const Environment& m_Env;
+        std::vector<Variable> m_Variables;
+    };
+
     class HelpCommand
     {
     public:
         HelpCommand(IArgParser& parser) :
-            m_Parser(parser),
-            m_Command(m_Parser, "help", "Prints this help message."),
+            m_Command(parser, "help", "Prints this help message."),
             m_PrintType(m_Command, "print", "P", "TYPE", "Print all subcommands and their options. (default: brief)", {"brief", "full"}, 0),
             m_HelpFor(m_Command, "CMD", "The path to the command to print the help message for.")
         {}
@@ -802,617 +2064,6734 @@ namespace Argue
         void operator()(ITextBuilder& help) const;
 
     private:
-        IArgParser& m_Parser;
+        // Its parent is the parser, even after it was moved
         CommandParser m_Command;
         ChoiceOption m_PrintType;
         StrVarArgument m_HelpFor;
     };
-}
 
-#endif // _ARGUE_HPP
+    /**
+     * Answers shell completion requests, which shells may issue on each key press:
+     *   PROGRAM __complete INDEX WORDS...
+     * WORDS are the words on the command line, the program's name included,
+     * INDEX is the index of the word being completed within them.
+     * Requests are answered without parsing, only looking up names
+     * within the parsers on the command line's path.
+     * Each request is a new process, which indexes the names of those parsers first. The names
+     * of a schema image are already sorted, answering from its SchemaView does not index anything.
+     */
+    class CompletionCommand
+    {
+    public:
+        CompletionCommand(const IArgParser& parser, std::string_view command="__complete") :
+            m_Parser(&parser),
+            m_Command(command)
+        {}
 
-#ifdef ARGUE_IMPLEMENTATION
+        // `schema` must outlive this command, e.g. the image of the program's parser tree
+        CompletionCommand(const SchemaView& schema, std::string_view command="__complete") :
+            m_Schema(&schema),
+            m_Command(command)
+        {}
 
-void Argue::TextBuilder::PutText(std::string_view text)
-{
-    std::string_view::size_type newLineIdx;
-    while ((newLineIdx = text.find('\n')) != std::string_view::npos) {
-        PutLine(text.substr(0, newLineIdx));
-        text.remove_prefix(newLineIdx+1);
-        NewLine();
-    }
-    PutLine(text);
-}
+        // Returns true if the arguments are a completion request, call it before parsing.
+        // The arguments must outlive this command.
+        bool Parse(int argc, const char** argv);
 
-void Argue::TextBuilder::NewLine()
-{
-    if (m_CurrentLine.length() > 0) {
-        if (!m_Text.empty()) m_Text += '\n';
+        operator bool() const { return m_IsRequested; }
+        void operator()(ITextBuilder& candidates) const;
 
-        while (m_CurrentLine.length() > 0 && IsSpace(m_CurrentLine.back()))
-            m_CurrentLine.pop_back();
-        m_Text += m_CurrentLine;
+        // Returns the sorted candidates for the word being completed
+        std::vector<std::string> GetCandidates() const;
 
-        m_CurrentLineIndentLength = 0;
-        m_CurrentLine.clear();
-    }
-}
+    private:
+        const IArgParser* m_Parser = nullptr;
+        const SchemaView* m_Schema = nullptr; // Answers instead of the parser if it's not nullptr
+        std::string m_Command;
 
-void Argue::TextBuilder::Spacer()
-{
-    NewLine();
-    if (!m_Text.ends_with('\n'))
-        m_Text += '\n';
-}
+        bool m_IsRequested = false;
+        std::vector<std::string_view> m_Words; // Words before the one being completed
+        std::string_view m_Word;
+    };
 
-void Argue::TextBuilder::Indent()
-{
-    ++m_IndentationLevel;
-}
+    enum class CompletionShell
+    {
+        Bash,
+        Zsh, // The bash script loaded through zsh's bashcompinit
+        Fish,
+    };
 
-void Argue::TextBuilder::DeIndent()
-{
-    if (m_IndentationLevel > 0)
-        --m_IndentationLevel;
-}
+    /**
+     * Returns a completion script for `shell` which completes `command` (e.g. "git").
+     * The whole parser tree is written within the script as data tables,
+     * so that completing does not run the program. Names must not contain spaces.
+     */
+    std::string GenerateCompletionScript(const IArgParser& parser, std::string_view command, CompletionShell shell);
+
+    /**
+     * Splits command lines into words like a POSIX shell does, without any expansion:
+     *   words are separated by spaces, a backslash escapes the next character,
+     *   '...' keeps everything and "..." keeps everything but escaped \ " $ ` and newlines.
+     * Words are views of the line when possible, i.e. when they were not escaped
+     * nor made of several quoted parts. Other words are unescaped within an arena
+     * owned by the tokenizer, they are valid until the next ::Tokenize().
+     */
+    class Tokenizer
+    {
+    public:
+        // Appends the words of `line` to `words`.
+        // Returns false and appends nothing if a quote is not closed or if the line ends with a backslash.
+        bool Tokenize(std::string_view line, std::vector<std::string_view>& words);
 
-std::string Argue::TextBuilder::Build()
-{
-    std::string result;
-    if (m_Text.empty()) {
-        result += m_CurrentLine;
-    } else {
-        result += m_Text;
-        result += '\n';
-        result += m_CurrentLine;
-    }
+    private:
+        // Grows but never shrinks, the unescaped words of a line are never longer than it
+        std::string m_Arena;
+    };
 
-    while (!result.empty() && IsSpace(result.back()))
-        result.pop_back();
-    result += '\n';
+    /**
+     * Parses command lines which are edited between parses, e.g. on each key press within a REPL.
+     * The parse is checkpointed after each word, a parse resumes after the words which did not change.
+     * Options and arguments set by the other words are reset, then the previous words which had
+     * set them are parsed again. Pass-through arguments are those of the last words, see ::Parse().
+     * While it lives, the parser must only be parsed through it. It may be moved, it's then parsed.
+     */
+    class IncrementalParser final :
+        public IParseObserver
+    {
+    public:
+        IncrementalParser(ArgParser& parser) :
+            m_Parser(&parser)
+        {
+            m_Parser->SetObserver(this);
+        }
 
-    return result;
-}
+        ~IncrementalParser() { m_Parser->SetObserver(nullptr); }
 
-void Argue::TextBuilder::PutLine(std::string_view text)
-{
-    while (true) {
-        size_t currentLineWidth = m_CurrentLine.length() - m_CurrentLineIndentLength;
-        bool hasWrapped = !m_CurrentLine.empty()    &&
-            currentLineWidth >= m_MaxParagraphWidth &&
-            (
-                IsSpace(m_CurrentLine.back()) ||
-                (!text.empty() && IsSpace(text[0]))
-            );
+        ARGUE_DELETE_MOVE_COPY(IncrementalParser)
 
-        if (hasWrapped) NewLine();
-        PutLineIndent(hasWrapped);
+        /**
+         * Same as IArgParser::Parse(), `words` start with the name of the parser.
+         * They are copied to be compared with the next words, so they may be views of a line which is then edited.
+         * Pass-through arguments are views of `words`, those of the previous words are removed.
+         */
+        bool Parse(const std::vector<std::string_view>& words);
 
-        std::string_view::size_type nextWordIdx = text.find_first_of(SPACE_CHARS);
-        if (nextWordIdx == std::string_view::npos) {
-            m_CurrentLine += text;
-            break;
-        }
+        // Follows the parser when it's moved
+        ArgParser& GetParser() const { return *m_Parser; }
 
-        if (nextWordIdx > 0) {
-            m_CurrentLine += text.substr(0, nextWordIdx);
-            m_CurrentLine += ' ';
-        } else if (!hasWrapped) {
-            m_CurrentLine += ' ';
-        }
-        text.remove_prefix(nextWordIdx+1);
-    }
-}
+        // The number of words which were not parsed again by the last ::Parse()
+        size_t GetReusedWordCount() const { return m_ReusedWordCount; }
+        // The number of words which were parsed successfully by the last ::Parse()
+        size_t GetParsedWordCount() const { return m_Checkpoints.size(); }
 
-void Argue::TextBuilder::PutLineIndent(bool hasWrapped)
-{
-    if (m_CurrentLine.empty()) {
-        m_CurrentLineIndentLength = m_IndentationLevel * m_Indent.length();
-        if (hasWrapped && m_IndentOnWrap) {
-            m_CurrentLineIndentLength += m_Indent.length();
-            m_CurrentLine += m_Indent;
-        }
+    public:
+        void OnWordParsed(const ParseState& state) override;
+        void OnOptionParsed(IOption& opt, std::string_view arg, bool isShort) override;
+        void OnArgumentParsed(IPositionalArgument& arg, std::string_view value) override;
+        void OnParserMoved(ArgParser& parser) override { m_Parser = &parser; }
 
-        for (size_t i = 0; i < m_IndentationLevel; ++i)
-            m_CurrentLine += m_Indent;
-    }
-}
+    private:
+        // Restores the state after the first `wordCount` words, everything is reset if it's 0
+        void Rollback(size_t wordCount);
 
-Argue::IOption::IOption(
-        IArgParser& parser,
-        std::string_view name,
-        std::string_view shortName,
-        std::string_view metaVar,
-        std::string_view description) :
-    m_Parser(parser),
-    m_Name(name),
-    m_ShortName(shortName),
-    m_MetaVar(metaVar),
-    m_Description(description)
-{
-    m_Parser.AddOption(*this);
-}
+    private:
+        struct ParsedValue
+        {
+            IOption* Option = nullptr;
+            IPositionalArgument* Argument = nullptr;
+            std::string Arg; // Options may have been given an abbreviated name's full name
+            bool IsShort = false;
+            bool HasLinkedOptions = false;
+        };
+
+        struct Checkpoint
+        {
+            ParseState State;
+            size_t PathLength = 0;
+            size_t ParsedValueCount = 0;
+            size_t PassThroughCount = 0;
+        };
+
+        ArgParser* m_Parser;
+        std::vector<std::string> m_Words; // Copies of the words of the last ::Parse()
+        std::vector<Checkpoint> m_Checkpoints; // One per parsed word
+        std::vector<IArgParser*> m_Path; // Parsers which were used, from the root one
+        std::vector<ParsedValue> m_ParsedValues; // In parsing order
+
+        bool m_IsReplaying = false;
+        size_t m_ReusedWordCount = 0;
+        std::vector<IOption*> m_LinkedOptions; // Reused by ::OnOptionParsed()
+        std::unordered_map<const void*, size_t> m_ParseCounts; // Reused by ::Rollback()
+    };
 
-void Argue::IOption::WriteHint(ITextBuilder& hint) const
-{
-    if (HasMetaVar()) {
-        const char VAR_OPEN  = IsVarOptional() ? '[' : '<';
-        const char VAR_CLOSE = IsVarOptional() ? ']' : '>';
+    // Owns a parser tree which is used by a single thread, see ParseBatch()
+    class IBatchWorker
+    {
+    public:
+        virtual ~IBatchWorker() = default;
 
-        if (m_Parser.HasShortPrefix() && HasShortName()) {
-            hint.PutText(s(
-                m_Parser.GetPrefix(), GetName(), '=', VAR_OPEN, GetMetaVar(), VAR_CLOSE, ", ",
-                m_Parser.GetShortPrefix(), GetShortName(), VAR_OPEN, GetMetaVar(), VAR_CLOSE
-            ));
-        } else {
-            hint.PutText(s(
-                m_Parser.GetPrefix(), GetName(), '=', VAR_OPEN, GetMetaVar(), VAR_CLOSE
+        virtual ArgParser& GetParser() = 0;
+        // Called by the worker's thread after each of its lines was parsed, e.g. to check values.
+        // Workers run at the same time, state shared between them must be synchronized.
+        virtual void OnParsed(size_t lineIdx, bool isValid)
+        {
+            ARGUE_UNUSED(lineIdx);
+            ARGUE_UNUSED(isValid);
+        }
+    };
+
+    struct BatchResult
+    {
+        bool IsValid = false;
+        std::string Error;
+        // The index of the word which failed to parse.
+        // It's the number of words if the line failed as a whole (e.g. a missing option)
+        size_t ErrorWordIdx = 0;
+    };
+
+    /**
+     * Parses each command line, whose first word is the program's name (e.g. a path) which is ignored.
+     * Parser trees hold the parsed values so they can't be shared between threads,
+     * each of the `threadCount` threads (one per core if 0) builds its own tree with `makeWorker`.
+     * `makeWorker` is called by all threads at once, so it must be thread-safe.
+     * If it or IBatchWorker::OnParsed() throws, the remaining lines are skipped and
+     * the first exception is rethrown once all threads have stopped.
+     * Threads take lines a chunk at a time, until there are none left.
+     * Trees parse their lines with an IncrementalParser, consecutive lines with the same first words are faster.
+     */
+    std::vector<BatchResult> ParseBatch(
+            const std::vector<std::vector<std::string_view>>& commandLines,
+            const std::function<std::unique_ptr<IBatchWorker>()>& makeWorker,
+            size_t threadCount=0);
+
+    /**
+     * Encodes whether `parser` parsed successfully, its error and the values of its tree into one buffer.
+     * Each option, positional argument and command of the tree has a value, see ResultView.
+     * Only the values of the commands which were used are present, commands are present as true.
+     * Numbers are written in the byte order of the machine.
+     */
+    std::string EncodeParseResult(const ArgParser& parser);
+
+    /**
+     * Reads an encoded result in place, e.g. within memory shared with another process.
+     * Values are identified by their index within the parser tree, which is the same for each
+     * result of that tree, or by their key: their path from the root parser (e.g. "install/force").
+     * The buffer starts with a header, then a bit per value telling whether it's present,
+     * then a slot per value. Strings follow, slots address them by their offset within the buffer.
+     */
+    class ResultView
+    {
+    public:
+        enum class ValueType : uint32_t
+        {
+            None, // The value is not present
+            Bool,
+            Int,
+            String,
+            Strings,
+        };
+
+        static constexpr size_t NPOS = SIZE_MAX;
+
+        // Returns false if `data` is not an encoded result, the view is then empty.
+        // Offsets within slots are checked when they are read.
+        bool Attach(std::string_view data);
+
+        bool IsValid() const { return m_IsValid; }
+        std::string_view GetError() const { return m_Error; }
+
+        size_t GetValueCount() const { return m_ValueCount; }
+        // Returns NPOS if no value has that key
+        size_t FindId(std::string_view key) const;
+        std::string_view GetKey(size_t id) const;
+        bool HasValue(size_t id) const;
+        ValueType GetType(size_t id) const;
+
+        // The default value is returned if the value is not present or has another type
+        bool GetBool(size_t id, bool defaultValue=false) const;
+        int64_t GetInt(size_t id, int64_t defaultValue=0) const;
+        std::string_view GetString(size_t id, std::string_view defaultValue="") const;
+        size_t GetStringCount(size_t id) const;
+        std::string_view GetStringAt(size_t id, size_t idx) const;
+
+        // Finds the value by its key first
+        bool GetBool(std::string_view key, bool defaultValue=false) const { return GetBool(FindId(key), defaultValue); }
+        int64_t GetInt(std::string_view key, int64_t defaultValue=0) const { return GetInt(FindId(key), defaultValue); }
+        std::string_view GetString(std::string_view key, std::string_view defaultValue="") const { return GetString(FindId(key), defaultValue); }
+
+    private:
+        struct Slot
+        {
+            uint32_t KeyOffset;
+            uint32_t KeyLength;
+            ValueType Type;
+            // The length of a string or the count of strings
+            uint32_t Length;
+            // The value of a bool or integer, the offset of a string or of the offsets and lengths of strings
+            int64_t Value;
+        };
+
+        bool ReadSlot(size_t id, Slot& slot) const;
+        // Returns an empty view if the string is not within the buffer
+        std::string_view ReadString(uint64_t offset, uint64_t length) const;
+
+    private:
+        std::string_view m_Data;
+        bool m_IsValid = false;
+        std::string_view m_Error;
+        size_t m_ValueCount = 0;
+        size_t m_SlotsOffset = 0;
+
+        friend class ResultEncoder;
+    };
+
+    // Owns the encoded result it views
+    class ParseResult :
+        public ResultView
+    {
+    public:
+        ParseResult() = default;
+
+        ARGUE_DELETE_MOVE_COPY(ParseResult)
+
+        bool Assign(std::string encoded)
+        {
+            m_Data = std::move(encoded);
+            return Attach(m_Data);
+        }
+
+    private:
+        std::string m_Data;
+    };
+
+    struct ReaderSlot;
+
+    /**
+     * Publishes the values of a parser tree to threads which read them while it's parsed again,
+     * e.g. when a service reloads its options.
+     * Each successful ::Reload() encodes the tree into a new immutable generation, which replaces
+     * the current one with a single atomic swap. Readers pin the current generation without waiting,
+     * replaced generations are freed once no reader which may see them is left.
+     */
+    class LiveConfig
+    {
+    public:
+        class Reader;
+
+        // Keeps the generation it views alive, see Reader::Read()
+        class Snapshot
+        {
+        public:
+            ~Snapshot();
+
+            ARGUE_DELETE_MOVE_COPY(Snapshot)
+
+            const ResultView& operator*() const { return *m_View; }
+            const ResultView* operator->() const { return m_View; }
+            // Starts at 1 with the first successful reload, 0 if there was none
+            uint64_t GetGeneration() const { return m_Generation; }
+
+        private:
+            Snapshot(Reader& reader);
+
+        private:
+            Reader& m_Reader;
+            const ResultView* m_View;
+            uint64_t m_Generation = 0;
+
+            friend class Reader;
+        };
+
+        // Used by a single thread, e.g. one per worker. Snapshots may be nested.
+        class Reader
+        {
+        public:
+            ~Reader();
+
+            ARGUE_DELETE_MOVE_COPY(Reader)
+
+            Snapshot Read() { return Snapshot(*this); }
+
+        private:
+            Reader(LiveConfig& config, ReaderSlot& slot);
+
+        private:
+            LiveConfig& m_Config;
+            ReaderSlot& m_Slot;
+            size_t m_SnapshotCount = 0;
+
+            friend class LiveConfig;
+            friend class Snapshot;
+        };
+
+        LiveConfig(ArgParser& parser, size_t maxReaderCount=64);
+        // All readers must be destroyed first
+        ~LiveConfig();
+
+        ARGUE_DELETE_MOVE_COPY(LiveConfig)
+
+        // Null if the config already has as many readers as it can have
+        std::unique_ptr<Reader> AddReader();
+
+        /**
+         * Parses `args`, which don't include the program's name, and publishes their values.
+         * Returns false if they are not valid, the current generation is then kept.
+         * The parser tree must only be parsed through it.
+         */
+        bool Reload(const std::vector<std::string_view>& args);
+
+        // The error of the last reload
+        std::string GetError() const;
+        // Replaced generations which may still be read
+        size_t GetRetiredCount() const;
+
+    private:
+        struct Generation
+        {
+            std::string Data;
+            ResultView View;
+            uint64_t Number;
+        };
+
+        struct RetiredGeneration
+        {
+            std::unique_ptr<Generation> Gen;
+            // Readers which pinned an earlier epoch may read it
+            uint64_t Epoch;
+        };
+
+        // Frees the retired generations which can't be read anymore
+        void Collect();
+
+    private:
+        std::atomic<Generation*> m_Current = nullptr;
+        std::atomic<uint64_t> m_Epoch = 0;
+        std::unique_ptr<ReaderSlot[]> m_Slots;
+        size_t m_SlotCount;
+
+        // Reloads are serialized, readers never take it
+        mutable std::mutex m_Mutex;
+        IncrementalParser m_Incremental; // Its parser may be moved
+        std::vector<std::string_view> m_Words;
+        std::vector<RetiredGeneration> m_Retired;
+        uint64_t m_GenerationCount = 0;
+    };
+
+#ifdef ARGUE_POSIX
+    /**
+     * Holds an encoded result within read-only shared memory, e.g. parsed once by a service before
+     * it forks its workers. Forked workers read its view in place, without a private copy of it.
+     * Other processes can map it from its file descriptor, which is closed on exec by default.
+     */
+    class SharedResult
+    {
+    public:
+        SharedResult() = default;
+        // Unmaps the result and closes its file descriptor
+        ~SharedResult();
+
+        ARGUE_DELETE_MOVE_COPY(SharedResult)
+
+        // Copies `encoded` into a new sealed memory file, see EncodeParseResult()
+        bool Publish(std::string_view encoded);
+        // Maps a result published by another process, `fd` may be closed afterwards
+        bool Map(int fd);
+
+        // The file descriptor of a published result, -1 if it was mapped
+        int GetFd() const { return m_Fd; }
+        const ResultView& operator*() const { return m_View; }
+        const ResultView* operator->() const { return &m_View; }
+
+        const std::string& GetError() const { return m_Error; }
+
+    private:
+        void Unmap();
+        // Always returns false, errno is described within the message
+        bool SetError(std::string_view message);
+
+    private:
+        int m_Fd = -1;
+        void* m_Data = nullptr;
+        size_t m_Size = 0;
+        ResultView m_View;
+        std::string m_Error;
+    };
+
+    /**
+     * Keeps a parser tree built and answers parse requests on a Unix domain socket, see RequestParse().
+     * The answer to a request is the EncodeParseResult() of its command line.
+     * Answers to the most recent command lines are cached, the program's name is not part of their key.
+     * The tree parses through an IncrementalParser and must not be changed while serving.
+     */
+    class ParseServer
+    {
+    public:
+        ParseServer(ArgParser& parser, size_t cacheCapacity=1024);
+
+        // Closes the socket and removes its file
+        ~ParseServer();
+
+        ARGUE_DELETE_MOVE_COPY(ParseServer)
+
+        // Creates the socket at `socketPath`. A socket which was left there by a server which is gone is replaced,
+        // listening fails if there is any other file or if a server still listens on it.
+        bool Listen(std::string_view socketPath);
+        // Answers requests until ::Stop() is called. Connections are served together without blocking on any,
+        // those which stay idle for too long are closed.
+        // Returns false if the server failed, see ::GetError()
+        bool Serve();
+        // May be called from another thread or from a signal handler
+        void Stop();
+
+        // Returns the answer to `request`, see RequestParse() for its format.
+        // It's valid until the next call.
+        std::string_view Answer(std::string_view request);
+
+        // The FingerprintSchema() of the parser tree, requests for other schemas are not answered
+        uint64_t GetFingerprint() const { return m_Fingerprint; }
+        const std::string& GetError() const { return m_Error; }
+
+    private:
+        // A client's connection, its requests are answered in order
+        struct Connection
+        {
+            int Fd;
+            std::string Input;  // Received bytes which are not part of an answered request
+            std::string Output; // Answers which are not sent yet
+            int64_t Deadline;   // When it's closed if it stays idle, in milliseconds
+        };
+
+        bool Accept(int64_t now);
+        // Both return false if the connection must be closed
+        bool Receive(Connection& connection);
+        bool Send(Connection& connection);
+        // Always returns false, errno is described within the message
+        bool SetError(std::string_view message);
+
+    private:
+        IncrementalParser m_Incremental; // Its parser may be moved
+        uint64_t m_Fingerprint;
+
+        int m_Fd = -1;
+        std::string m_SocketPath;
+        std::atomic<bool> m_IsStopped = false;
+        std::string m_Error;
+
+        std::vector<Connection> m_Connections;
+        std::vector<std::string_view> m_Words;
+        std::string m_Answer; // Used if answers are not cached
+
+        // The most recent answer is at the front, keys are views of requests within the list
+        using CacheEntry = std::pair<std::string, std::string>;
+        size_t m_CacheCapacity;
+        std::list<CacheEntry> m_Cache;
+        std::unordered_map<std::string_view, std::list<CacheEntry>::iterator> m_CacheIndex;
+    };
+
+    /**
+     * Asks the ParseServer listening at `socketPath` to parse `argv`, `result` then holds its answer.
+     * `fingerprint` is the FingerprintSchema() of the program's parser tree, e.g. the FINGERPRINT of
+     * GenerateSchemaSource(), so that a server built from another version of the program does not answer.
+     * Returns false if the server could not be reached or did not answer, the program should then parse `argv` itself.
+     * A request is its length, then the fingerprint, then the arguments, each one ending with a null character.
+     * An answer is its length followed by the encoded result, it's empty if the fingerprints differ.
+     * Lengths are 32 bits long, fingerprints 64 bits long.
+     */
+    bool RequestParse(std::string_view socketPath, uint64_t fingerprint, int argc, const char** argv, ParseResult& result);
+#endif // ARGUE_POSIX
+
+    /**
+     * Encodes the schema of a parser tree into an image which a SchemaView reads in place,
+     * e.g. generated at build time or cached on disk, then mapped at startup instead of building the tree.
+     * Returns an empty string if an option or positional argument is not of a built-in type, see IOption::WriteSchema().
+     * Observers and bindings are not part of the schema. Numbers are written in the byte order of the machine.
+     */
+    std::string EncodeSchema(const ArgParser& parser);
+
+    // Identifies a schema `image`, it's the 64-bit FNV-1a hash of its bytes
+    uint64_t FingerprintSchema(std::string_view image);
+
+    /**
+     * Parses command lines and writes help from a schema image in place, without building the parser tree.
+     * The result of a command line is the same as the EncodeParseResult() of the encoded tree once it parsed it.
+     * The image starts with a header, then a record per value in the order of their IDs, then a record per command.
+     * Strings, lists and sorted names follow, records address them by their offset within the image.
+     * Words are parsed and help is laid out by the same code as for the tree, hints and help of
+     * options and arguments are recorded from it.
+     */
+    class SchemaView
+    {
+    public:
+        static constexpr uint32_t VERSION = 3;
+
+        // Returns false if `image` is not a schema image of this version, the view is then empty.
+        // The whole image is checked, so it must not change while it's viewed.
+        bool Attach(std::string_view image);
+
+        bool IsEmpty() const { return m_CommandCount == 0; }
+        // The name of the root parser, i.e. the program
+        std::string_view GetName() const;
+
+        /**
+         * Encodes the result of parsing `args` into `result`, `args` starts with the program's path, which is not
+         * checked against the name of the schema. Unknown options and unexpected positional arguments are appended to
+         * `passThrough` instead of being errors if it's not nullptr, see ArgParser::SetPassThrough(). Returns result.IsValid().
+         */
+        bool Parse(
+                const std::vector<std::string_view>& args,
+                ParseResult& result,
+                std::vector<std::string_view>* passThrough=nullptr) const;
+        bool Parse(
+                int argc,
+                const char** argv,
+                ParseResult& result,
+                std::vector<std::string_view>* passThrough=nullptr) const;
+
+        // Same as IArgParser::WriteHelp() of the encoded root parser
+        void WriteHelp(ITextBuilder& help, bool briefOptions=false, bool briefSubcommands=true) const;
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX;
+        static constexpr uint32_t AMBIGUOUS = UINT32_MAX-1;
+
+        // A string, or a list of records, within the image
+        struct Span
+        {
+            uint32_t Offset;
+            uint32_t Length;
+        };
+
+        struct Header
+        {
+            uint32_t Magic;
+            uint32_t Version;
+            uint32_t Size;
+            uint32_t ValueCount;
+            uint32_t CommandCount;
+            Span Prefix;
+            Span ShortPrefix;
+        };
+
+        // An option, a positional argument or a subcommand
+        struct ValueRecord
+        {
+            SchemaEntry::Kind Type;
+            uint8_t HasDefault;
+            uint8_t IsVarOptional;
+            uint8_t Padding;
+            // The index of the command, NONE if the value is not a subcommand
+            uint32_t Command;
+            Span Key;
+            Span Name; // The meta variable of positional arguments
+            Span ShortName;
+            Span MetaVar;
+            Span Description;
+            Span DefaultString;
+            Span Aliases; // Spans
+            Span Choices; // Spans
+            Span Linked;  // IDs of flags, including the flags of nested groups
+            Span Hint;    // TextRecords of the option's or argument's WriteHint()
+            Span Help;    // TextRecords of its WriteHelp()
+            Span Completions; // Spans, the option's sorted CompleteValue("")
+            int64_t DefaultInt;
+        };
+
+        struct CommandRecord
+        {
+            uint32_t Id; // NONE for the root parser
+            Span Name;
+            Span Description;
+            // Options and positional arguments are consecutive values
+            uint32_t FirstOption;
+            uint32_t OptionCount;
+            uint32_t FirstArgument;
+            uint32_t ArgumentCount;
+            Span SubCommands;   // Indices of commands
+            Span OptionNames;   // NameRecords sorted by name, see IArgParser::GetOptionNames()
+            Span CommandNames;  // NameRecords sorted by name, see IArgParser::GetCommandNames()
+            Span ShortNames;    // NameRecords sorted by name, see IArgParser::GetShortOptionNames()
+            Span CustomOptions; // Indices of options, see IArgParser::GetCustomOptions()
+            Span Hint;          // TextRecords of IArgParser::WriteHint()
+        };
+
+        struct NameRecord
+        {
+            Span Name;
+            uint32_t Index;
+        };
+
+        // A call to an ITextBuilder, see ::WriteText()
+        struct TextRecord
+        {
+            enum class Call : uint32_t { PutText, NewLine, Spacer, Indent, DeIndent };
+
+            Call Method;
+            Span Text; // Of PutText()
+        };
+
+        template<typename Record>
+        Record Read(uint64_t offset) const;
+        template<typename Record>
+        Record ReadAt(Span list, size_t idx) const { return Read<Record>(list.Offset + uint64_t(idx) * sizeof(Record)); }
+
+        ValueRecord ReadValue(size_t id) const;
+        CommandRecord ReadCommand(size_t idx) const;
+        std::string_view ReadString(Span str) const { return m_Data.substr(str.Offset, str.Length); }
+
+        // Returns false if `list` is not within the image
+        bool CheckSpan(Span list, size_t recordSize) const;
+        bool CheckValue(const ValueRecord& value) const;
+        // Also checks that values are numbered in the same order as results, see EncodeValues()
+        bool CheckCommand(size_t idx, uint32_t id, size_t depth, uint32_t& nextId, std::vector<bool>& isVisited) const;
+        bool CheckNames(Span names, size_t count) const;
+        bool CheckText(Span text) const;
+
+        // Replays the calls recorded from the tree
+        void WriteText(ITextBuilder& builder, Span text) const;
+        // See CompletionCommand::GetCandidates(), `words` start with the program's name
+        void Complete(const std::vector<std::string_view>& words, std::string_view word, std::vector<std::string>& candidates) const;
+
+    private:
+        std::string_view m_Data;
+        size_t m_ValueCount = 0;
+        size_t m_CommandCount = 0;
+        std::string_view m_Prefix;
+        std::string_view m_ShortPrefix;
+
+        friend class SchemaEncoder;
+        friend class TextRecorder;
+        friend class SchemaParser;
+        friend class ImageCommand;
+        friend class CompletionCommand;
+        friend class SchemaSourceWriter;
+    };
+
+    /**
+     * Returns C++ source which parses with `schema` without building nor mapping anything, e.g. generated at build time:
+     *   the image as data, the help as written by a default TextBuilder, a `Values` struct with a field per value
+     *   initialized to its default, and the functions which fill it. It's all defined within the `ns` namespace.
+     * The source includes "argue.hpp" and can be included by several files, the implementation is not included.
+     * Returns an empty string if the view is empty.
+     */
+    std::string GenerateSchemaSource(const SchemaView& schema, std::string_view ns);
+
+#ifdef ARGUE_POSIX
+    // A read-only private mapping of a whole file, e.g. a schema image, see SchemaView
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+
+        ARGUE_DELETE_MOVE_COPY(MappedFile)
+
+        // Maps the file at `path` in place of the one which was mapped
+        bool Open(const std::string& path);
+        void Close();
+
+        std::string_view GetData() const { return { static_cast<const char*>(m_Data), m_Size }; }
+        const std::string& GetError() const { return m_Error; }
+
+    private:
+        // Always returns false, errno is described within the message
+        bool SetError(std::string_view message);
+
+    private:
+        void* m_Data = nullptr;
+        size_t m_Size = 0;
+        std::string m_Error;
+    };
+#endif // ARGUE_POSIX
+
+    /**
+     * A configuration file of `key = value` lines, which is tokenized in place, see FileBinding.
+     * Lines which start with '#' or ';' are comments, a `[section]` line starts a section (e.g. "install" or
+     * "install/force"), keys before the first one are within the "" section. Spaces around keys and values
+     * are ignored, a value may be quoted to keep them. Repeated keys are all kept, in order.
+     */
+    class ConfigFile
+    {
+    public:
+        struct Entry
+        {
+            std::string_view Section;
+            std::string_view Key;
+            std::string_view Value;
+            size_t Line;
+        };
+
+        ConfigFile() = default;
+
+        ARGUE_DELETE_MOVE_COPY(ConfigFile)
+
+        // Loads the file at `path` in place of the one which was loaded.
+        // The file is mapped if possible, see MappedFile, otherwise it's read.
+        bool Open(const std::string& path);
+        // `text` must outlive this file, `name` (e.g. its path) is written within error messages
+        bool Load(std::string_view text, std::string_view name);
+
+        // Sorted by section, entries of the same section are in the order of the file
+        const std::vector<Entry>& GetEntries() const { return m_Entries; }
+        // Returns the index of the first entry of `section`, `count` is set to the number of its entries
+        size_t FindSection(std::string_view section, size_t& count) const;
+
+        const std::string& GetName() const { return m_Name; }
+        const std::string& GetError() const { return m_Error; }
+
+    private:
+        // Always returns false, the entries are cleared
+        bool SetError(std::string&& errorMessage);
+
+    private:
+#ifdef ARGUE_POSIX
+        MappedFile m_File;
+#else
+        std::string m_Text;
+#endif
+        std::string m_Name;
+        std::vector<Entry> m_Entries;
+        std::string m_Error;
+    };
+
+    /**
+     * Gives the options of a parser which were not parsed the values of a section of a ConfigFile,
+     * keys being their names or aliases. Values are parsed by the options, see IOption::ParseFallback(),
+     * so the command line and sources which were added before (e.g. an EnvBinding) come first.
+     * Options of subcommands are bound by a binding of their command, which is only resolved if it was used.
+     */
+    class FileBinding final :
+        public IValueSource
+    {
+    public:
+        // `file` must live as long as this binding
+        FileBinding(IArgParser& parser, const ConfigFile& file, std::string_view section="") :
+            IValueSource(parser),
+            m_File(file),
+            m_Section(section)
+        {}
+
+        virtual ~FileBinding() = default;
+
+        ARGUE_DELETE_MOVE_COPY(FileBinding)
+
+    public:
+        bool Resolve(IArgParser& parser) override;
+
+    private:
+        // Describes where `entry` is within the file for error messages, e.g. "'app.conf' line 3"
+        std::string GetOrigin(const ConfigFile::Entry& entry) const;
+
+    private:
+        const ConfigFile& m_File;
+        std::string m_Section;
+        // Whether each option was parsed before ::Resolve(), reused by it
+        std::vector<bool> m_WasParsed;
+    };
+
+    // Called when a StaticText runs out of space.
+    // It is not constexpr, so overflowing at compile time is an error.
+    inline void StaticTextOverflow() {}
+
+    // Fixed capacity text which can be built in constant expressions
+    template<size_t Capacity>
+    class StaticText
+    {
+    public:
+        constexpr StaticText() = default;
+
+        // Allows copying into a text with a different capacity (e.g. the exact size)
+        template<size_t OtherCapacity>
+        constexpr StaticText(const StaticText<OtherCapacity>& other)
+        {
+            Append(other.View());
+        }
+
+        constexpr size_t Size() const { return m_Size; }
+        constexpr bool IsEmpty() const { return m_Size == 0; }
+        // true if something was not appended because the capacity was exceeded
+        constexpr bool HasOverflowed() const { return m_HasOverflowed; }
+
+        constexpr const char* Data() const { return m_Data; }
+        constexpr std::string_view View() const { return { m_Data, m_Size }; }
+
+        constexpr char& operator[](size_t idx) { return m_Data[idx]; }
+        constexpr char operator[](size_t idx) const { return m_Data[idx]; }
+        constexpr char Back() const { return m_Data[m_Size-1]; }
+
+        constexpr void Append(char ch)
+        {
+            if (m_Size >= Capacity) {
+                m_HasOverflowed = true;
+                StaticTextOverflow();
+                return;
+            }
+            m_Data[m_Size++] = ch;
+        }
+
+        constexpr void Append(std::string_view text)
+        {
+            for (char ch : text)
+                Append(ch);
+        }
+
+        constexpr void PopBack() { --m_Size; }
+
+    private:
+        char m_Data[Capacity > 0 ? Capacity : 1] = {};
+        size_t m_Size = 0;
+        bool m_HasOverflowed = false;
+    };
+
+    /**
+     * Same as TextBuilder, but usable in constant expressions.
+     * The text is built within a StaticText, the current line being at its end.
+     */
+    template<size_t Capacity>
+    class StaticTextBuilder :
+        public TextWrapper<StaticTextBuilder<Capacity>>
+    {
+    public:
+        // `indent` must outlive this builder
+        constexpr StaticTextBuilder(
+                std::string_view indent="  ",
+                bool indentOnWrap=true,
+                size_t maxParagraphWidth=80) :
+            TextWrapper<StaticTextBuilder>(indentOnWrap, maxParagraphWidth),
+            m_Indent(indent)
+        {}
+
+        constexpr void NewLine()
+        {
+            if (m_HasLine) {
+                while (m_Text.Size() > m_LineStart && IsSpace(m_Text.Back()))
+                    m_Text.PopBack();
+                m_HasLine = false;
+                this->EndLine();
+            }
+        }
+
+        constexpr void Spacer()
+        {
+            NewLine();
+            if (m_Text.IsEmpty() || m_Text.Back() != '\n')
+                m_Text.Append('\n');
+        }
+
+        // Same text as TextBuilder::Build()
+        constexpr StaticText<Capacity> Build()
+        {
+            StaticText<Capacity> result = m_Text;
+            while (!result.IsEmpty() && IsSpace(result.Back()))
+                result.PopBack();
+            result.Append('\n');
+            return result;
+        }
+
+    private:
+        friend class TextWrapper<StaticTextBuilder>;
+
+        constexpr bool HasLine() const { return m_HasLine; }
+        constexpr char GetLineBack() const { return m_Text.Back(); }
+        constexpr void AppendIndent() { AppendToLine(m_Indent, false); }
+        constexpr void AppendWords(std::string_view words) { AppendToLine(words, true); }
+
+        constexpr void AppendToLine(std::string_view text, bool isWords)
+        {
+            if (text.empty())
+                return;
+
+            // Lines are separated by a new line, like TextBuilder does
+            if (!m_HasLine) {
+                if (!m_Text.IsEmpty()) m_Text.Append('\n');
+                m_LineStart = m_Text.Size();
+                m_HasLine = true;
+            }
+
+            for (char ch : text)
+                m_Text.Append(isWords && IsSpace(ch) ? ' ' : ch);
+        }
+
+    private:
+        StaticText<Capacity> m_Text;
+
+        bool m_HasLine = false;
+        size_t m_LineStart = 0;
+
+        std::string_view m_Indent;
+    };
+
+    // A view over a constant array, used by static schemas
+    template<typename T>
+    class StaticList
+    {
+    public:
+        constexpr StaticList() = default;
+
+        template<size_t N>
+        constexpr StaticList(const T (&items)[N]) :
+            m_Items(items),
+            m_Size(N)
+        {}
+
+        constexpr StaticList(const T* items, size_t size) :
+            m_Items(items),
+            m_Size(size)
+        {}
+
+        constexpr size_t size() const { return m_Size; }
+        constexpr const T* begin() const { return m_Items; }
+        constexpr const T* end() const { return m_Items + m_Size; }
+        constexpr const T& operator[](size_t idx) const { return m_Items[idx]; }
+
+    private:
+        const T* m_Items = nullptr;
+        size_t m_Size = 0;
+    };
+
+    /**
+     * Describes an option at compile time, see StaticCommand.
+     * Its help is the same as the one of the equivalent option type.
+     */
+    class StaticOption
+    {
+    public:
+        static constexpr size_t HINT_CAPACITY = 1024;
+
+        // Same as IntOption, StrOption and CollectionOption
+        static constexpr StaticOption Value(
+                std::string_view name,
+                std::string_view shortName,
+                std::string_view metaVar,
+                std::string_view description,
+                bool isVarOptional=false)
+        {
+            return StaticOption(name, shortName, metaVar, description, isVarOptional, false, false, {});
+        }
+
+        // Same as FlagOption
+        static constexpr StaticOption Flag(
+                std::string_view name,
+                std::string_view shortName,
+                std::string_view description)
+        {
+            return StaticOption(name, shortName, "", description, true, true, false, {});
+        }
+
+        // Same as ChoiceOption
+        static constexpr StaticOption Choice(
+                std::string_view name,
+                std::string_view shortName,
+                std::string_view metaVar,
+                std::string_view description,
+                StaticList<std::string_view> choices)
+        {
+            return StaticOption(name, shortName, metaVar, description, false, false, true, choices);
+        }
+
+        // Same as IOption::AddAlias(), e.g. StaticOption::Flag("verbose", "v", "Print more.").WithAliases(ALIASES)
+        constexpr StaticOption WithAliases(StaticList<std::string_view> aliases) const
+        {
+            StaticOption opt = *this;
+            opt.m_Aliases = aliases;
+            return opt;
+        }
+
+        constexpr std::string_view GetName() const { return m_Name; }
+        constexpr std::string_view GetShortName() const { return m_ShortName; }
+        constexpr std::string_view GetMetaVar() const { return m_MetaVar; }
+        constexpr std::string_view GetDescription() const { return m_Description; }
+        constexpr StaticList<std::string_view> GetChoices() const { return m_Choices; }
+        constexpr StaticList<std::string_view> GetAliases() const { return m_Aliases; }
+
+        constexpr bool HasShortName() const { return !m_ShortName.empty(); }
+        constexpr bool HasMetaVar() const { return !m_MetaVar.empty(); }
+        constexpr bool HasDescription() const { return !m_Description.empty(); }
+        constexpr bool IsVarOptional() const { return m_IsVarOptional; }
+        constexpr bool IsFlag() const { return m_IsFlag; }
+        constexpr bool IsChoice() const { return m_IsChoice; }
+
+        // Same as IOption::WriteHint() and its overrides
+        template<typename Builder>
+        constexpr void WriteHint(Builder& hint, std::string_view prefix, std::string_view shortPrefix) const
+        {
+            const bool hasShort = !shortPrefix.empty() && HasShortName();
+
+            // The hint is put as a whole, like IOption does
+            StaticText<HINT_CAPACITY> text;
+            text.Append(prefix);
+            text.Append(GetName());
+            if (IsChoice()) {
+                text.Append('=');
+                AppendChoices(text);
+                if (hasShort) {
+                    text.Append(", ");
+                    text.Append(shortPrefix);
+                    text.Append(GetShortName());
+                    AppendChoices(text);
+                }
+            } else if (HasMetaVar() && !IsFlag()) {
+                const char VAR_OPEN  = IsVarOptional() ? '[' : '<';
+                const char VAR_CLOSE = IsVarOptional() ? ']' : '>';
+                text.Append('=');
+                text.Append(VAR_OPEN);
+                text.Append(GetMetaVar());
+                text.Append(VAR_CLOSE);
+                if (hasShort) {
+                    text.Append(", ");
+                    text.Append(shortPrefix);
+                    text.Append(GetShortName());
+                    text.Append(VAR_OPEN);
+                    text.Append(GetMetaVar());
+                    text.Append(VAR_CLOSE);
+                }
+            } else if (hasShort) {
+                text.Append(", ");
+                text.Append(shortPrefix);
+                text.Append(GetShortName());
+            }
+            for (std::string_view alias : m_Aliases) {
+                text.Append(", ");
+                text.Append(prefix);
+                text.Append(alias);
+            }
+            hint.PutText(text.View());
+        }
+
+        // Same as IOption::WriteHelp() and its overrides
+        template<typename Builder>
+        constexpr void WriteHelp(Builder& help, std::string_view prefix, std::string_view shortPrefix) const
+        {
+            WriteHint(help, prefix, shortPrefix);
+            if (IsFlag()) {
+                help.PutText(", ");
+                if (!shortPrefix.empty() && HasShortName())
+                    help.NewLine();
+
+                StaticText<HINT_CAPACITY> negated;
+                negated.Append(prefix);
+                negated.Append("no-");
+                negated.Append(GetName());
+                help.PutText(negated.View());
+            }
+
+            if (HasDescription()) {
+                help.NewLine();
+                help.Indent();
+                help.PutText(GetDescription());
+                help.DeIndent();
+            }
+        }
+
+    private:
+        constexpr StaticOption(
+                std::string_view name,
+                std::string_view shortName,
+                std::string_view metaVar,
+                std::string_view description,
+                bool isVarOptional,
+                bool isFlag,
+                bool isChoice,
+                StaticList<std::string_view> choices) :
+            m_Name(name),
+            m_ShortName(shortName),
+            m_MetaVar(metaVar),
+            m_Description(description),
+            m_IsVarOptional(isVarOptional),
+            m_IsFlag(isFlag),
+            m_IsChoice(isChoice),
+            m_Choices(choices)
+        {}
+
+        // Same as ChoiceOption::GetChoiceString()
+        template<size_t Capacity>
+        constexpr void AppendChoices(StaticText<Capacity>& text) const
+        {
+            text.Append('{');
+            for (size_t i = 0; i < m_Choices.size(); ++i) {
+                if (i > 0) text.Append(',');
+                text.Append(m_Choices[i]);
+            }
+            text.Append('}');
+        }
+
+    private:
+        std::string_view m_Name;
+        std::string_view m_ShortName;
+        std::string_view m_MetaVar;
+        std::string_view m_Description;
+        bool m_IsVarOptional;
+        bool m_IsFlag;
+        bool m_IsChoice;
+        StaticList<std::string_view> m_Choices;
+        StaticList<std::string_view> m_Aliases;
+    };
+
+    // Describes a positional argument at compile time, see StaticCommand
+    class StaticArgument
+    {
+    public:
+        constexpr StaticArgument(
+                std::string_view metaVar,
+                std::string_view description,
+                bool hasDefaultValue=false,
+                bool isVariadic=false) :
+            m_MetaVar(metaVar),
+            m_Description(description),
+            m_HasDefault(hasDefaultValue || isVariadic),
+            m_IsVariadic(isVariadic)
+        {}
+
+        constexpr std::string_view GetMetaVar() const { return m_MetaVar; }
+        constexpr std::string_view GetDescription() const { return m_Description; }
+        constexpr bool HasDescription() const { return !m_Description.empty(); }
+        constexpr bool HasDefaultValue() const { return m_HasDefault; }
+        constexpr bool IsVariadic() const { return m_IsVariadic; }
+
+        // Same as IPositionalArgument::WriteHint()
+        template<typename Builder>
+        constexpr void WriteHint(Builder& hint) const
+        {
+            StaticText<StaticOption::HINT_CAPACITY> text;
+            if (HasDefaultValue()) {
+                text.Append(IsVariadic() ? "[..." : "[");
+                text.Append(GetMetaVar());
+                text.Append(']');
+            } else {
+                text.Append('<');
+                text.Append(GetMetaVar());
+                text.Append('>');
+            }
+            hint.PutText(text.View());
+        }
+
+        // Same as IPositionalArgument::WriteHelp()
+        template<typename Builder>
+        constexpr void WriteHelp(Builder& help) const
+        {
+            StaticText<StaticOption::HINT_CAPACITY> text;
+            if (IsVariadic()) text.Append("...");
+            text.Append(GetMetaVar());
+            text.Append(':');
+            help.PutText(text.View());
+
+            if (HasDescription()) {
+                help.NewLine();
+                help.Indent();
+                help.PutText(GetDescription());
+                help.DeIndent();
+            }
+        }
+
+    private:
+        std::string_view m_MetaVar;
+        std::string_view m_Description;
+        bool m_HasDefault;
+        bool m_IsVariadic;
+    };
+
+    /**
+     * The layout of IArgParser::WriteHelp() and StaticCommand::WriteHelp(), so that both write the same help.
+     * Command has the const help methods of ICommandSchema, which are called with `help`.
+     */
+    template<typename Command, typename Builder>
+    constexpr void WriteCommandHelp(const Command& cmd, Builder& help, bool briefOptions, bool briefSubcommands)
+    {
+        cmd.WriteHint(help);
+        help.Spacer();
+
+        if (!cmd.GetDescription().empty()) {
+            help.Indent();
+            help.PutText(cmd.GetDescription());
+            help.DeIndent();
+            help.Spacer();
+        }
+
+        for (size_t i = 0; i < cmd.GetArgumentCount(); ++i) {
+            if (cmd.ArgumentHasDescription(i)) {
+                cmd.WriteArgumentHelp(i, help);
+                help.Spacer();
+            }
+        }
+
+        if (cmd.GetOptionCount() > 0) {
+            help.PutText("OPTIONS:");
+            help.NewLine();
+            if (briefOptions) {
+                for (size_t i = 0; i < cmd.GetOptionCount(); ++i) {
+                    help.Indent();
+                    cmd.WriteOptionHint(i, help);
+                    help.DeIndent();
+                    help.NewLine();
+                }
+                help.Spacer();
+            } else {
+                for (size_t i = 0; i < cmd.GetOptionCount(); ++i) {
+                    help.Indent();
+                    cmd.WriteOptionHelp(i, help);
+                    help.DeIndent();
+                    help.Spacer();
+                }
+            }
+        }
+
+        if (cmd.GetSubCommandCount() > 0) {
+            help.PutText("SUBCOMMANDS:");
+            help.NewLine();
+            if (briefSubcommands) {
+                for (size_t i = 0; i < cmd.GetSubCommandCount(); ++i) {
+                    help.Indent();
+                    cmd.WriteSubCommandHint(i, help);
+                    help.DeIndent();
+                    help.NewLine();
+                }
+                help.Spacer();
+            } else {
+                for (size_t i = 0; i < cmd.GetSubCommandCount(); ++i) {
+                    help.Indent();
+                    cmd.WriteSubCommandHelp(i, help, briefOptions, briefSubcommands);
+                    help.DeIndent();
+                    help.Spacer();
+                }
+            }
+        }
+    }
+
+    /**
+     * Describes a command and its subcommands at compile time, so that its help
+     * message can be rendered by a StaticTextBuilder into read-only data:
+     *   constexpr StaticOption OPTIONS[] = { StaticOption::Flag("verbose", "v", "Print more.") };
+     *   constexpr StaticCommand PROGRAM("prog", "My program.", OPTIONS);
+     *   constexpr auto HELP = RenderStaticHelp<4096>(PROGRAM);
+     * The help is the same as the one written by IArgParser::WriteHelp()
+     * for the equivalent parser.
+     */
+    class StaticCommand
+    {
+    public:
+        constexpr StaticCommand(
+                std::string_view name,
+                std::string_view description,
+                StaticList<StaticOption> options={},
+                StaticList<StaticArgument> arguments={},
+                StaticList<StaticCommand> commands={}) :
+            m_Name(name),
+            m_Description(description),
+            m_Options(options),
+            m_Arguments(arguments),
+            m_Commands(commands)
+        {}
+
+        // Same as IArgParser::AddAlias()
+        constexpr StaticCommand WithAliases(StaticList<std::string_view> aliases) const
+        {
+            StaticCommand cmd = *this;
+            cmd.m_Aliases = aliases;
+            return cmd;
+        }
+
+        constexpr std::string_view GetName() const { return m_Name; }
+        constexpr std::string_view GetDescription() const { return m_Description; }
+        constexpr bool HasDescription() const { return !m_Description.empty(); }
+        constexpr StaticList<std::string_view> GetAliases() const { return m_Aliases; }
+
+        constexpr StaticList<StaticOption> GetOptions() const { return m_Options; }
+        constexpr StaticList<StaticArgument> GetArguments() const { return m_Arguments; }
+        constexpr StaticList<StaticCommand> GetSubCommands() const { return m_Commands; }
+
+        // Same as IArgParser::WriteHint()
+        template<typename Builder>
+        constexpr void WriteHint(Builder& hint) const
+        {
+            hint.PutText(GetName());
+            for (std::string_view alias : m_Aliases) {
+                hint.PutText("|");
+                hint.PutText(alias);
+            }
+            if (m_Options.size() > 0) {
+                hint.PutText(" [...OPTIONS]");
+            }
+            if (m_Commands.size() > 0) {
+                StaticText<StaticOption::HINT_CAPACITY> subcommands;
+                subcommands.Append(" [");
+                for (size_t i = 0; i < m_Commands.size(); ++i) {
+                    if (i > 0) subcommands.Append('|');
+                    subcommands.Append(m_Commands[i].GetName());
+                }
+                subcommands.Append(" ...]");
+                hint.PutText(subcommands.View());
+            }
+            if (m_Arguments.size() > 0) {
+                hint.PutText(" [--]");
+                for (const StaticArgument& arg : m_Arguments) {
+                    hint.PutText(" ");
+                    arg.WriteHint(hint);
+                }
+            }
+        }
+
+        // Same as IArgParser::WriteHelp()
+        template<typename Builder>
+        constexpr void WriteHelp(
+                Builder& help,
+                bool briefOptions=false,
+                bool briefSubcommands=true,
+                std::string_view prefix="--",
+                std::string_view shortPrefix="-") const
+        {
+            WriteCommandHelp(HelpSchema(*this, prefix, shortPrefix), help, briefOptions, briefSubcommands);
+        }
+
+    private:
+        // A StaticCommand as seen by WriteCommandHelp(), options are written with the given prefixes
+        class HelpSchema
+        {
+        public:
+            constexpr HelpSchema(const StaticCommand& command, std::string_view prefix, std::string_view shortPrefix) :
+                m_Command(command),
+                m_Prefix(prefix),
+                m_ShortPrefix(shortPrefix)
+            {}
+
+            constexpr std::string_view GetDescription() const { return m_Command.m_Description; }
+            constexpr size_t GetOptionCount() const { return m_Command.m_Options.size(); }
+            constexpr size_t GetArgumentCount() const { return m_Command.m_Arguments.size(); }
+            constexpr size_t GetSubCommandCount() const { return m_Command.m_Commands.size(); }
+
+            template<typename Builder>
+            constexpr void WriteHint(Builder& hint) const { m_Command.WriteHint(hint); }
+            template<typename Builder>
+            constexpr void WriteOptionHint(size_t idx, Builder& hint) const
+            {
+                m_Command.m_Options[idx].WriteHint(hint, m_Prefix, m_ShortPrefix);
+            }
+            template<typename Builder>
+            constexpr void WriteOptionHelp(size_t idx, Builder& help) const
+            {
+                m_Command.m_Options[idx].WriteHelp(help, m_Prefix, m_ShortPrefix);
+            }
+            constexpr bool ArgumentHasDescription(size_t idx) const { return m_Command.m_Arguments[idx].HasDescription(); }
+            template<typename Builder>
+            constexpr void WriteArgumentHelp(size_t idx, Builder& help) const { m_Command.m_Arguments[idx].WriteHelp(help); }
+            template<typename Builder>
+            constexpr void WriteSubCommandHint(size_t idx, Builder& hint) const { m_Command.m_Commands[idx].WriteHint(hint); }
+            template<typename Builder>
+            constexpr void WriteSubCommandHelp(size_t idx, Builder& help, bool briefOptions, bool briefSubcommands) const
+            {
+                m_Command.m_Commands[idx].WriteHelp(help, briefOptions, briefSubcommands, m_Prefix, m_ShortPrefix);
+            }
+
+        private:
+            const StaticCommand& m_Command;
+            std::string_view m_Prefix;
+            std::string_view m_ShortPrefix;
+        };
+
+    private:
+        std::string_view m_Name;
+        std::string_view m_Description;
+        StaticList<StaticOption> m_Options;
+        StaticList<StaticArgument> m_Arguments;
+        StaticList<StaticCommand> m_Commands;
+        StaticList<std::string_view> m_Aliases;
+    };
+
+    /**
+     * Renders the help message of `program` in a constant expression.
+     * Compilation fails if the message does not fit within Capacity bytes,
+     * the exact size can then be used to shrink it:
+     *   constexpr auto HELP_MAX = RenderStaticHelp<8192>(PROGRAM);
+     *   constexpr StaticText<HELP_MAX.Size()> HELP = HELP_MAX;
+     */
+    template<size_t Capacity>
+    constexpr StaticText<Capacity> RenderStaticHelp(
+            const StaticCommand& program,
+            bool briefOptions=false,
+            bool briefSubcommands=true,
+            std::string_view prefix="--",
+            std::string_view shortPrefix="-",
+            std::string_view indent="  ",
+            bool indentOnWrap=true,
+            size_t maxParagraphWidth=80)
+    {
+        StaticTextBuilder<Capacity> help(indent, indentOnWrap, maxParagraphWidth);
+        program.WriteHelp(help, briefOptions, briefSubcommands, prefix, shortPrefix);
+        return help.Build();
+    }
+
+    // TextWrapper in a constant expression, the text is the one TextBuilder builds for the same calls
+    static_assert([] {
+        StaticTextBuilder<64> help("  ", true, 12);
+        help.PutText("OPTIONS:");
+        help.NewLine();
+        help.Indent();
+        help.PutText("Wraps\twords past the width.");
+        help.Spacer();
+        help.PutText("Done.");
+        return help.Build();
+    }().View() == "OPTIONS:\n  Wraps words\n    past the width.\n\n  Done.\n");
+}
+
+#endif // _ARGUE_HPP
+
+#ifdef ARGUE_IMPLEMENTATION
+
+namespace Argue
+{
+    // Bit tricks to check 8 bytes at a time, see
+    //  https://graphics.stanford.edu/~seander/bithacks.html#HasLessInWord
+    constexpr uint64_t SWAR_ONES  = 0x0101010101010101ull;
+    constexpr uint64_t SWAR_HIGHS = 0x8080808080808080ull;
+
+    // true if any byte in block is less than n (n <= 128)
+    constexpr bool SwarHasLess(uint64_t block, uint8_t n)
+    {
+        return ((block - SWAR_ONES * n) & ~block & SWAR_HIGHS) != 0;
+    }
+
+    // true if any byte in block is equal to ch
+    constexpr bool SwarHasByte(uint64_t block, char ch)
+    {
+        return SwarHasLess(block ^ (SWAR_ONES * static_cast<uint8_t>(ch)), 1);
+    }
+}
+
+size_t Argue::FindSpace(std::string_view text, size_t pos)
+{
+    const char* data = text.data();
+    const size_t size = text.size();
+
+    size_t i = pos;
+#ifdef ARGUE_SSE2
+    const __m128i space   = _mm_set1_epi8(' ');
+    const __m128i rangeLo = _mm_set1_epi8('\t' - 1);
+    const __m128i rangeHi = _mm_set1_epi8('\r' + 1);
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i isSpace = _mm_or_si128(
+            _mm_cmpeq_epi8(block, space),
+            _mm_and_si128(_mm_cmpgt_epi8(block, rangeLo), _mm_cmplt_epi8(block, rangeHi)));
+        if (_mm_movemask_epi8(isSpace) != 0)
+            break;
+    }
+#else
+    for (; i + 8 <= size; i += 8) {
+        uint64_t block;
+        std::memcpy(&block, data + i, 8);
+        if (SwarHasLess(block, '\r' + 1) || SwarHasByte(block, ' '))
+            break;
+    }
+#endif
+
+    // The space is within the current block, if any
+    for (; i < size; ++i) {
+        if (IsSpace(data[i]))
+            return i;
+    }
+    return std::string_view::npos;
+}
+
+bool Argue::IsAscii(std::string_view text)
+{
+    const char* data = text.data();
+    const size_t size = text.size();
+
+    size_t i = 0;
+#ifdef ARGUE_SSE2
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(block) != 0)
+            return false;
+    }
+#else
+    for (; i + 8 <= size; i += 8) {
+        uint64_t block;
+        std::memcpy(&block, data + i, 8);
+        if ((block & SWAR_HIGHS) != 0)
+            return false;
+    }
+#endif
+
+    for (; i < size; ++i) {
+        if (static_cast<uint8_t>(data[i]) >= 0x80)
+            return false;
+    }
+    return true;
+}
+
+void Argue::WrappingTextBuilder::PutText(std::string_view text)
+{
+    TextWrapper::PutText(text);
+}
+
+void Argue::WrappingTextBuilder::NewLine()
+{
+    if (m_CurrentLine.length() > 0) {
+        while (m_CurrentLine.length() > 0 && IsSpace(m_CurrentLine.back()))
+            m_CurrentLine.pop_back();
+        WriteLine(m_CurrentLine);
+
+        EndLine();
+        m_CurrentLine.clear();
+    }
+}
+
+void Argue::WrappingTextBuilder::Spacer()
+{
+    NewLine();
+    WriteSpacer();
+}
+
+void Argue::WrappingTextBuilder::Indent()
+{
+    TextWrapper::Indent();
+}
+
+void Argue::WrappingTextBuilder::DeIndent()
+{
+    TextWrapper::DeIndent();
+}
+
+void Argue::WrappingTextBuilder::Reset()
+{
+    ResetWrapping();
+    m_CurrentLine.clear();
+}
+
+void Argue::TextBuilder::WriteLine(std::string_view line)
+{
+    if (!m_Text.empty()) m_Text += '\n';
+    m_Text += line;
+}
+
+void Argue::TextBuilder::WriteSpacer()
+{
+    if (!m_Text.ends_with('\n'))
+        m_Text += '\n';
+}
+
+std::string Argue::TextBuilder::Build()
+{
+    // The text is finished in place, so that a reserved buffer does not need to grow
+    std::string_view lastLine = GetCurrentLine();
+    while (!lastLine.empty() && IsSpace(lastLine.back()))
+        lastLine.remove_suffix(1);
+
+    if (lastLine.empty()) {
+        while (!m_Text.empty() && IsSpace(m_Text.back()))
+            m_Text.pop_back();
+    } else {
+        if (!m_Text.empty()) m_Text += '\n';
+        m_Text += lastLine;
+    }
+    m_Text += '\n';
+
+    std::string result = std::move(m_Text);
+    Reset();
+    return result;
+}
+
+void Argue::TextBuilder::Reset()
+{
+    WrappingTextBuilder::Reset();
+    m_Text.clear();
+}
+
+void Argue::WrappingTextBuilder::AppendWords(std::string_view words)
+{
+    size_t i = m_CurrentLine.length();
+    m_CurrentLine += words;
+
+    // Most spaces are already ' ', so skip blocks without other space characters
+    char* data = m_CurrentLine.data();
+    const size_t size = m_CurrentLine.length();
+    while (i < size) {
+        if (i + 8 <= size) {
+            uint64_t block;
+            std::memcpy(&block, data + i, 8);
+            if (!SwarHasLess(block, '\r' + 1)) {
+                i += 8;
+                continue;
+            }
+        }
+
+        if (IsSpace(data[i]))
+            data[i] = ' ';
+        ++i;
+    }
+}
+
+std::string Argue::StreamingTextBuilder::Build()
+{
+    // Same as TextBuilder::Build(), held back new lines are trailing spaces
+    std::string_view lastLine = GetCurrentLine();
+    while (!lastLine.empty() && IsSpace(lastLine.back()))
+        lastLine.remove_suffix(1);
+
+    if (!lastLine.empty()) {
+        if (m_HasText) ++m_PendingNewLines;
+        PutPendingNewLines();
+        Put(lastLine);
+    }
+    Put("\n");
+    Finish();
+
+    Reset();
+    return "";
+}
+
+void Argue::StreamingTextBuilder::Reset()
+{
+    WrappingTextBuilder::Reset();
+    m_HasText = false;
+    m_PendingNewLines = 0;
+}
+
+void Argue::StreamingTextBuilder::WriteLine(std::string_view line)
+{
+    if (m_HasText) ++m_PendingNewLines;
+    if (!line.empty()) {
+        PutPendingNewLines();
+        Put(line);
+        m_HasText = true;
+    }
+}
+
+void Argue::StreamingTextBuilder::WriteSpacer()
+{
+    if (m_PendingNewLines == 0) {
+        ++m_PendingNewLines;
+        m_HasText = true;
+    }
+}
+
+void Argue::StreamingTextBuilder::PutPendingNewLines()
+{
+    for (; m_PendingNewLines > 0; --m_PendingNewLines)
+        Put("\n");
+}
+
+void Argue::FileTextBuilder::Reset()
+{
+    StreamingTextBuilder::Reset();
+    m_BufferSize = 0;
+}
+
+void Argue::FileTextBuilder::Put(std::string_view text)
+{
+    if (m_BufferSize + text.length() <= BUFFER_CAPACITY) {
+        std::memcpy(m_Buffer + m_BufferSize, text.data(), text.length());
+        m_BufferSize += text.length();
+    } else {
+        Flush(text);
+    }
+}
+
+void Argue::CountingTextBuilder::Reset()
+{
+    StreamingTextBuilder::Reset();
+    m_Counted = 0;
+}
+
+void Argue::FileTextBuilder::Flush(std::string_view data)
+{
+    if (m_File) {
+        if (std::fwrite(m_Buffer, 1, m_BufferSize, m_File) != m_BufferSize)
+            m_HasError = true;
+        if (!data.empty() && std::fwrite(data.data(), 1, data.length(), m_File) != data.length())
+            m_HasError = true;
+        if (data.empty() && std::fflush(m_File) != 0)
+            m_HasError = true;
+        m_BufferSize = 0;
+        return;
+    }
+
+#ifdef ARGUE_POSIX
+    // Buffer and data are written together, data is not copied into the buffer
+    iovec chunks[2] = {
+        { m_Buffer, m_BufferSize },
+        { const_cast<char*>(data.data()), data.length() },
+    };
+    iovec* chunk = chunks;
+    int chunkCount = 2;
+    while (chunkCount > 0) {
+        if (chunk->iov_len == 0) {
+            ++chunk;
+            --chunkCount;
+            continue;
+        }
+
+        ssize_t written = writev(m_Fd, chunk, chunkCount);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            m_HasError = true;
+            break;
+        }
+
+        size_t remaining = static_cast<size_t>(written);
+        while (chunkCount > 0 && remaining >= chunk->iov_len) {
+            remaining -= chunk->iov_len;
+            ++chunk;
+            --chunkCount;
+        }
+        if (chunkCount > 0) {
+            chunk->iov_base = static_cast<char*>(chunk->iov_base) + remaining;
+            chunk->iov_len -= remaining;
+        }
+    }
+#endif // ARGUE_POSIX
+    m_BufferSize = 0;
+}
+
+bool Argue::NameTrie::Insert(std::string_view name, size_t index)
+{
+    if (Find(name) != NPOS)
+        return false;
+
+    if (m_Nodes.empty())
+        m_Nodes.emplace_back();
+
+    size_t node = 0;
+    while (true) {
+        size_t& subtreeIndex = m_Nodes[node].SubtreeIndex;
+        subtreeIndex = subtreeIndex == NPOS || subtreeIndex == index ? index : AMBIGUOUS;
+        if (name.empty())
+            break;
+
+        // Find the child which shares the first byte, or where to insert it
+        size_t prevChild = NPOS;
+        size_t child = m_Nodes[node].FirstChild;
+        while (child != NPOS &&
+                static_cast<uint8_t>(m_Nodes[child].FirstByte) < static_cast<uint8_t>(name[0])) {
+            prevChild = child;
+            child = m_Nodes[child].NextSibling;
+        }
+
+        if (child == NPOS || m_Nodes[child].FirstByte != name[0]) {
+            Node leaf;
+            leaf.LabelStart  = m_Labels.size();
+            leaf.LabelLength = name.size();
+            leaf.FirstByte   = name[0];
+            leaf.Index        = index;
+            leaf.SubtreeIndex = index;
+            leaf.NextSibling  = child;
+            m_Labels += name;
+
+            child = m_Nodes.size();
+            m_Nodes.push_back(leaf);
+            if (prevChild == NPOS) {
+                m_Nodes[node].FirstChild = child;
+            } else m_Nodes[prevChild].NextSibling = child;
+            return true;
+        }
+
+        std::string_view label = GetLabel(child);
+        size_t common = 1;
+        while (common < label.size() && common < name.size() && label[common] == name[common])
+            ++common;
+
+        if (common < label.size()) {
+            // Split the child's label, the new node takes its place
+            Node split;
+            split.LabelStart  = m_Nodes[child].LabelStart;
+            split.LabelLength = common;
+            split.FirstByte    = name[0];
+            split.SubtreeIndex = m_Nodes[child].SubtreeIndex;
+            split.FirstChild   = child;
+            split.NextSibling = m_Nodes[child].NextSibling;
+
+            m_Nodes[child].LabelStart  += common;
+            m_Nodes[child].LabelLength -= common;
+            m_Nodes[child].FirstByte    = m_Labels[m_Nodes[child].LabelStart];
+            m_Nodes[child].NextSibling  = NPOS;
+
+            child = m_Nodes.size();
+            m_Nodes.push_back(split);
+            if (prevChild == NPOS) {
+                m_Nodes[node].FirstChild = child;
+            } else m_Nodes[prevChild].NextSibling = child;
+        }
+
+        name.remove_prefix(common);
+        node = child;
+    }
+
+    m_Nodes[node].Index = index;
+    return true;
+}
+
+size_t Argue::NameTrie::Find(std::string_view name) const
+{
+    if (m_Nodes.empty())
+        return NPOS;
+
+    size_t node = 0;
+    while (!name.empty()) {
+        node = m_Nodes[node].FirstChild;
+        while (node != NPOS && m_Nodes[node].FirstByte != name[0])
+            node = m_Nodes[node].NextSibling;
+
+        if (node == NPOS || !name.starts_with(GetLabel(node)))
+            return NPOS;
+        name.remove_prefix(m_Nodes[node].LabelLength);
+    }
+    return m_Nodes[node].Index;
+}
+
+size_t Argue::NameTrie::FindUnique(std::string_view name, std::string& match) const
+{
+    match.clear();
+    if (m_Nodes.empty())
+        return NPOS;
+
+    size_t node = 0;
+    std::string_view rest = name;
+    while (!rest.empty()) {
+        node = m_Nodes[node].FirstChild;
+        while (node != NPOS && m_Nodes[node].FirstByte != rest[0])
+            node = m_Nodes[node].NextSibling;
+        if (node == NPOS)
+            return NPOS;
+
+        std::string_view label = GetLabel(node);
+        if (label.starts_with(rest)) {
+            // The name ends within this label
+            match += label;
+            rest = {};
+        } else if (rest.starts_with(label)) {
+            match += label;
+            rest.remove_prefix(label.size());
+        } else return NPOS;
+    }
+
+    // An exact match is preferred, even if longer names have different indices
+    if (match.size() == name.size() && m_Nodes[node].Index != NPOS)
+        return m_Nodes[node].Index;
+
+    size_t index = m_Nodes[node].SubtreeIndex;
+    if (index == AMBIGUOUS || index == NPOS)
+        return index;
+
+    while (m_Nodes[node].Index == NPOS) {
+        node = m_Nodes[node].FirstChild;
+        match += GetLabel(node);
+    }
+    return index;
+}
+
+void Argue::NameTrie::FindPrefixesOf(std::string_view name, std::vector<size_t>& indices) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    size_t node = 0;
+    while (!name.empty()) {
+        node = m_Nodes[node].FirstChild;
+        while (node != NPOS && m_Nodes[node].FirstByte != name[0])
+            node = m_Nodes[node].NextSibling;
+
+        if (node == NPOS || !name.starts_with(GetLabel(node)))
+            return;
+        name.remove_prefix(m_Nodes[node].LabelLength);
+        if (m_Nodes[node].Index != NPOS)
+            indices.push_back(m_Nodes[node].Index);
+    }
+}
+
+void Argue::NameTrie::FindWithPrefix(std::string_view prefix, std::vector<Match>& matches) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    std::string name;
+    size_t node = 0;
+    while (!prefix.empty()) {
+        node = m_Nodes[node].FirstChild;
+        while (node != NPOS && m_Nodes[node].FirstByte != prefix[0])
+            node = m_Nodes[node].NextSibling;
+        if (node == NPOS)
+            return;
+
+        std::string_view label = GetLabel(node);
+        if (label.starts_with(prefix)) {
+            // The prefix ends within this label, all names below match
+            prefix = {};
+        } else if (prefix.starts_with(label)) {
+            prefix.remove_prefix(label.size());
+        } else return;
+        name += label;
+    }
+    CollectMatches(node, name, matches);
+}
+
+void Argue::NameTrie::CollectMatches(size_t node, std::string& name, std::vector<Match>& matches) const
+{
+    if (m_Nodes[node].Index != NPOS)
+        matches.push_back({ name, m_Nodes[node].Index });
+
+    for (size_t child = m_Nodes[node].FirstChild; child != NPOS; child = m_Nodes[child].NextSibling) {
+        size_t nameLength = name.size();
+        name += GetLabel(child);
+        CollectMatches(child, name, matches);
+        name.resize(nameLength);
+    }
+}
+
+void Argue::NameTrie::FindClosest(std::string_view name, size_t maxDistance, std::vector<Match>& matches) const
+{
+    const size_t patternLength = name.size();
+    if (m_Nodes.empty() || patternLength == 0 || patternLength > 64)
+        return;
+
+    // Myers' bit-parallel edit distance, as adapted by Hyyrö for whole strings.
+    // Each trie node continues from the state of its parent, so shared prefixes are computed once.
+    uint64_t peq[256] = {};
+    for (size_t i = 0; i < patternLength; ++i)
+        peq[static_cast<uint8_t>(name[i])] |= uint64_t(1) << i;
+    const uint64_t lastBit = uint64_t(1) << (patternLength-1);
+
+    struct Frame
+    {
+        size_t Node;
+        size_t ParentNameLength;
+        uint64_t VP, VN;
+        size_t Distance;
+    };
+
+    std::vector<Frame> frames;
+    frames.push_back({ 0, 0, ~uint64_t(0), 0, patternLength });
+
+    size_t bestDistance = maxDistance;
+    size_t firstMatch = matches.size();
+    std::string current;
+    while (!frames.empty()) {
+        Frame frame = frames.back();
+        frames.pop_back();
+
+        current.resize(frame.ParentNameLength);
+        current += GetLabel(frame.Node);
+
+        bool isPruned = false;
+        for (size_t i = frame.ParentNameLength; i < current.size(); ++i) {
+            // Longer names are more than bestDistance edits away
+            if (i+1 > patternLength + bestDistance) {
+                isPruned = true;
+                break;
+            }
+
+            uint64_t eq = peq[static_cast<uint8_t>(current[i])];
+            uint64_t xv = eq | frame.VN;
+            uint64_t xh = (((eq & frame.VP) + frame.VP) ^ frame.VP) | eq;
+            uint64_t ph = frame.VN | ~(xh | frame.VP);
+            uint64_t mh = frame.VP & xh;
+            if (ph & lastBit) {
+                ++frame.Distance;
+            } else if (mh & lastBit) {
+                --frame.Distance;
+            }
+            ph = (ph << 1) | 1;
+            mh = mh << 1;
+            frame.VP = mh | ~(xv | ph);
+            frame.VN = ph & xv;
+        }
+
+        if (isPruned)
+            continue;
+
+        const Node& node = m_Nodes[frame.Node];
+        if (node.Index != NPOS && frame.Distance <= bestDistance) {
+            if (frame.Distance < bestDistance) {
+                bestDistance = frame.Distance;
+                matches.resize(firstMatch);
+            }
+            matches.push_back({ current, node.Index });
+        }
+
+        // Children are pushed in reverse, so that matches are found in lexicographic order
+        size_t firstChild = frames.size();
+        for (size_t child = node.FirstChild; child != NPOS; child = m_Nodes[child].NextSibling)
+            frames.push_back({ child, current.size(), frame.VP, frame.VN, frame.Distance });
+        std::reverse(frames.begin() + firstChild, frames.end());
+    }
+}
+
+namespace Argue
+{
+    // Returns " Did you mean ...?" with the names closest to `unknown`, or an empty string
+    static std::string BuildSuggestion(const NameTrie& names, std::string_view prefix, std::string_view unknown)
+    {
+        constexpr size_t MAX_SUGGESTIONS = 3;
+
+        std::vector<NameTrie::Match> matches;
+        names.FindClosest(unknown, std::max<size_t>(1, unknown.size() / 3), matches);
+        if (matches.empty())
+            return "";
+
+        std::string suggestion = matches.size() > 1 ? " Did you mean one of " : " Did you mean ";
+        for (size_t i = 0; i < matches.size() && i < MAX_SUGGESTIONS; ++i) {
+            if (i > 0) suggestion += ", ";
+            suggestion += s('\'', prefix, matches[i].Name, '\'');
+        }
+        suggestion += '?';
+        return suggestion;
+    }
+}
+
+Argue::IConfigBinding::IConfigBinding(IArgParser& parser)
+{
+    parser.AddBinding(*this);
+}
+
+Argue::IValueSource::IValueSource(IArgParser& parser) :
+    m_Parser(&parser)
+{
+    m_Parser->AddSource(*this);
+}
+
+Argue::IOption::IOption(
+        IArgParser& parser,
+        std::string_view name,
+        std::string_view shortName,
+        std::string_view metaVar,
+        std::string_view description) :
+    m_Parser(&parser),
+    m_Name(name),
+    m_ShortName(shortName),
+    m_MetaVar(metaVar),
+    m_Description(description)
+{
+    m_Handle = m_Parser->AddOption(*this);
+}
+
+Argue::IOption::IOption(IOption&& other) noexcept :
+    m_WasParsed(other.m_WasParsed),
+    m_IsFallback(other.m_IsFallback),
+    m_Parser(other.m_Parser),
+    m_Handle(other.m_Handle),
+    m_Name(std::move(other.m_Name)),
+    m_ShortName(std::move(other.m_ShortName)),
+    m_MetaVar(std::move(other.m_MetaVar)),
+    m_Description(std::move(other.m_Description)),
+    m_Aliases(std::move(other.m_Aliases)),
+    m_Hint(std::move(other.m_Hint))
+{
+    m_Parser->RelocateOption(m_Handle, *this);
+}
+
+Argue::IOption& Argue::IOption::AddAlias(std::string_view alias)
+{
+    m_Aliases.emplace_back(alias);
+    m_Hint.Clear();
+    m_Parser->OnSchemaChanged();
+    return *this;
+}
+
+std::vector<std::string> Argue::IOption::GetLongNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(1 + m_Aliases.size());
+    names.push_back(GetName());
+    names.insert(names.end(), m_Aliases.begin(), m_Aliases.end());
+    return names;
+}
+
+void Argue::IOption::WriteHint(ITextBuilder& hint) const
+{
+    hint.PutText(m_Hint.Get([this](std::string& text) {
+        text = BuildHint();
+        for (const std::string& alias : m_Aliases)
+            text += s(", ", m_Parser->GetPrefix(), alias);
+    }));
+}
+
+std::string Argue::IOption::BuildHint() const
+{
+    if (HasMetaVar()) {
+        const char VAR_OPEN  = IsVarOptional() ? '[' : '<';
+        const char VAR_CLOSE = IsVarOptional() ? ']' : '>';
+
+        if (m_Parser->HasShortPrefix() && HasShortName()) {
+            return s(
+                m_Parser->GetPrefix(), GetName(), '=', VAR_OPEN, GetMetaVar(), VAR_CLOSE, ", ",
+                m_Parser->GetShortPrefix(), GetShortName(), VAR_OPEN, GetMetaVar(), VAR_CLOSE
+            );
+        } else {
+            return s(
+                m_Parser->GetPrefix(), GetName(), '=', VAR_OPEN, GetMetaVar(), VAR_CLOSE
+            );
+        }
+    } else {
+        if (m_Parser->HasShortPrefix() && HasShortName()) {
+            return s(
+                m_Parser->GetPrefix(), GetName(), ", ",
+                m_Parser->GetShortPrefix(), GetShortName()
+            );
+        } else {
+            return s(
+                m_Parser->GetPrefix(), GetName()
+            );
+        }
+    }
+}
+
+void Argue::IOption::WriteHelp(ITextBuilder& help) const
+{
+    WriteHint(help);
+    if (HasDescription()) {
+        help.NewLine();
+        help.Indent();
+        help.PutText(GetDescription());
+        help.DeIndent();
+    }
+}
+
+namespace Argue
+{
+    // See IOption::ConsumeName(), `getAlias(i)` returns each of the option's aliases.
+    // Schema images parse with it too, see SchemaParser.
+    template<typename GetAlias>
+    static bool ConsumeOptionName(
+            std::string_view& arg,
+            bool isShort,
+            std::string_view name,
+            std::string_view shortName,
+            size_t aliasCount,
+            const GetAlias& getAlias)
+    {
+        if (isShort) {
+            if (shortName.empty() || !arg.starts_with(shortName))
+                return false;
+            arg.remove_prefix(shortName.length());
+            return true;
+        }
+
+        size_t nameLength = arg.starts_with(name) ? name.length() : 0;
+        for (size_t i = 0; i < aliasCount; ++i) {
+            const std::string_view alias = getAlias(i);
+            if (alias.length() > nameLength && arg.starts_with(alias))
+                nameLength = alias.length();
+        }
+
+        if (nameLength == 0)
+            return false;
+        arg.remove_prefix(nameLength);
+        return true;
+    }
+
+    // See IOption::IsLongName()
+    template<typename GetAlias>
+    static bool IsOptionName(std::string_view name, std::string_view optionName, size_t aliasCount, const GetAlias& getAlias)
+    {
+        if (name == optionName)
+            return true;
+        for (size_t i = 0; i < aliasCount; ++i) {
+            if (name == getAlias(i))
+                return true;
+        }
+        return false;
+    }
+
+    // The rules below are those of the built-in option types, SchemaParser parses with them too
+    //  so that a parser tree and its schema image accept the same words.
+
+    // See FlagOption::ParseArg(), `isLongName(name)` is IOption::IsLongName().
+    // Returns false if `arg` is not one of the flag's names, `flag` is then left as is.
+    template<typename IsLongName>
+    static bool ParseFlagArg(std::string_view arg, bool isShort, bool hasConsumedName, const IsLongName& isLongName, bool& flag)
+    {
+        if (hasConsumedName) {
+            if (!arg.empty())
+                return false;
+            flag = true;
+            return true;
+        }
+
+        if (isShort || !arg.starts_with("no-"))
+            return false;
+        arg.remove_prefix(3);
+        if (!isLongName(arg))
+            return false;
+        flag = false;
+        return true;
+    }
+
+    // See IOption::ParseArg(), the value of long options with a MetaVar follows '='
+    static bool ConsumeValueSeparator(std::string_view& arg, bool isShort, bool hasMetaVar)
+    {
+        if (!isShort && hasMetaVar) {
+            if (!arg.starts_with('='))
+                return false;
+            arg.remove_prefix(1);
+        }
+        return true;
+    }
+
+    // See IntOption::ParseValue(), `value` is only set if `val` is a base 10 integer which fits
+    static bool ParseIntValue(
+            std::string_view val,
+            std::string_view prefix,
+            std::string_view name,
+            int64_t& value,
+            std::string& error)
+    {
+        int64_t number = 0;
+        auto result = std::from_chars(val.data(), val.data() + val.size(), number, 10);
+        if (val.empty() || result.ec != std::errc() || result.ptr != val.data() + val.size()) {
+            error = s("Expected integer for '", prefix, name, "', got '", val, "'.");
+            return false;
+        }
+        value = number;
+        return true;
+    }
+
+    // Returns "{a,b,c}" with the choices returned by `getChoice(i)`, see ChoiceOption::GetChoiceString()
+    template<typename GetChoice>
+    static std::string BuildChoiceString(size_t choiceCount, const GetChoice& getChoice)
+    {
+        std::string result = "{";
+        for (size_t i = 0; i < choiceCount; ++i) {
+            if (i > 0) result += ',';
+            result += getChoice(i);
+        }
+        result += '}';
+        return result;
+    }
+
+    // See ChoiceOption::ParseValue(), `choiceIdx` is set to the index of the choice `val` is
+    template<typename GetChoice>
+    static bool ParseChoiceValue(
+            std::string_view val,
+            size_t choiceCount,
+            const GetChoice& getChoice,
+            std::string_view prefix,
+            std::string_view name,
+            size_t& choiceIdx,
+            std::string& error)
+    {
+        for (size_t i = 0; i < choiceCount; ++i) {
+            if (getChoice(i) == val) {
+                choiceIdx = i;
+                return true;
+            }
+        }
+        error = s("Expected one of ", BuildChoiceString(choiceCount, getChoice), " for '", prefix, name, "', got '", val, "'.");
+        return false;
+    }
+
+    // See CollectionOption::ParseValue()
+    static bool CheckCollectionValue(
+            std::string_view val,
+            bool acceptEmptyValues,
+            std::string_view prefix,
+            std::string_view name,
+            std::string& error)
+    {
+        if (!acceptEmptyValues && val.empty()) {
+            error = s("Empty values are not allowed for '", prefix, name, "'.");
+            return false;
+        }
+        return true;
+    }
+}
+
+bool Argue::IOption::Parse(std::string_view arg, bool isShort)
+{
+    // e.g. collections must not append to the fallback
+    if (m_IsFallback)
+        Reset();
+    if (!ParseArg(arg, isShort))
+        return false;
+
+    m_WasParsed = true;
+    if (IParseObserver* observer = m_Parser->GetObserver())
+        observer->OnOptionParsed(*this, arg, isShort);
+    return true;
+}
+
+bool Argue::IOption::ParseArg(std::string_view arg, bool isShort)
+{
+    if (!ConsumeName(arg, isShort) || !ConsumeValueSeparator(arg, isShort, HasMetaVar()))
+        return false;
+    return ParseValue(arg);
+}
+
+bool Argue::IOption::ParseFallback(std::string_view value)
+{
+    // A source may give several values, e.g. to a collection
+    if (m_WasParsed && !m_IsFallback)
+        return true;
+
+    if (!ParseValue(value)) {
+        ResetValue();
+        return false;
+    }
+
+    m_WasParsed = true;
+    m_IsFallback = true;
+    return true;
+}
+
+bool Argue::IOption::SetError(std::string&& errorMessage)
+{
+    return m_Parser->SetError(std::forward<std::string>(errorMessage));
+}
+
+bool Argue::IOption::ConsumeName(std::string_view& arg, bool isShort)
+{
+    return ConsumeOptionName(arg, isShort, GetName(), GetShortName(), m_Aliases.size(),
+        [this](size_t i) -> std::string_view { return m_Aliases[i]; });
+}
+
+bool Argue::IOption::IsLongName(std::string_view name) const
+{
+    return IsOptionName(name, GetName(), m_Aliases.size(),
+        [this](size_t i) -> std::string_view { return m_Aliases[i]; });
+}
+
+Argue::IPositionalArgument::IPositionalArgument(IArgParser& parser, std::string_view metaVar, std::string_view description) :
+    m_Parser(&parser),
+    m_MetaVar(metaVar),
+    m_Description(description)
+{
+    m_Handle = m_Parser->AddArgument(*this);
+}
+
+Argue::IPositionalArgument::IPositionalArgument(IPositionalArgument&& other) noexcept :
+    m_WasParsed(other.m_WasParsed),
+    m_Parser(other.m_Parser),
+    m_Handle(other.m_Handle),
+    m_MetaVar(std::move(other.m_MetaVar)),
+    m_Description(std::move(other.m_Description))
+{
+    m_Parser->RelocateArgument(m_Handle, *this);
+}
+
+void Argue::IPositionalArgument::WriteHint(ITextBuilder& hint) const
+{
+    if (HasDefaultValue()) {
+        if (IsVariadic()) {
+            hint.PutText(s("[...", GetMetaVar(), ']'));
+        } else{
+            hint.PutText(s('[', GetMetaVar(), ']'));
+        }
+    } else {
+        hint.PutText(s('<', GetMetaVar(), '>'));
+    }
+}
+
+void Argue::IPositionalArgument::WriteHelp(ITextBuilder& help) const
+{
+    if (IsVariadic()) {
+        help.PutText(s("...", GetMetaVar(), ':'));
+    } else {
+        help.PutText(s(GetMetaVar(), ':'));
+    }
+    if (HasDescription()) {
+        help.NewLine();
+        help.Indent();
+        help.PutText(GetDescription());
+        help.DeIndent();
+    }
+}
+
+bool Argue::IPositionalArgument::Parse(std::string_view arg)
+{
+    if (!ParseArg(arg))
+        return false;
+
+    m_WasParsed = true;
+    if (IParseObserver* observer = m_Parser->GetObserver())
+        observer->OnArgumentParsed(*this, arg);
+    return true;
+}
+
+bool Argue::IPositionalArgument::SetError(std::string&& errorMessage)
+{
+    return m_Parser->SetError(std::forward<std::string>(errorMessage));
+}
+
+Argue::IArgParser::IArgParser(IArgParser&& other) noexcept :
+    m_WasUsed(other.m_WasUsed),
+    m_Name(std::move(other.m_Name)),
+    m_Description(std::move(other.m_Description)),
+    m_Aliases(std::move(other.m_Aliases)),
+    m_Options(std::move(other.m_Options)),
+    m_Commands(std::move(other.m_Commands)),
+    m_Arguments(std::move(other.m_Arguments)),
+    m_Bindings(std::move(other.m_Bindings)),
+    m_Sources(std::move(other.m_Sources)),
+    m_Help(other.m_Help.exchange(nullptr)),
+    m_HelpVersion(other.m_HelpVersion)
+{
+    for (IOption* opt : m_Options)
+        opt->m_Parser = this;
+    for (IPositionalArgument* arg : m_Arguments)
+        arg->m_Parser = this;
+    for (IValueSource* source : m_Sources)
+        source->m_Parser = this;
+    for (IArgParser* cmd : m_Commands)
+        cmd->RelocateParent(*this);
+}
+
+Argue::IArgParser& Argue::IArgParser::AddAlias(std::string_view alias)
+{
+    m_Aliases.emplace_back(alias);
+    OnSchemaChanged();
+    return *this;
+}
+
+const Argue::NameTrie& Argue::IArgParser::GetCommandNames() const
+{
+    return m_CommandNames.Get([this](NameTrie& commandNames) {
+        size_t namesCount = 0, namesLength = 0;
+        for (const IArgParser* cmd : m_Commands) {
+            namesCount += 1 + cmd->GetAliases().size();
+            namesLength += cmd->GetName().size();
+            for (const std::string& alias : cmd->GetAliases())
+                namesLength += alias.size();
+        }
+
+        // Like when parsing, the first command with a given name wins.
+        // Names are inserted before aliases, so that they can't be shadowed by them.
+        commandNames.Clear();
+        commandNames.Reserve(namesCount, namesLength);
+        for (size_t i = 0; i < m_Commands.size(); ++i)
+            commandNames.Insert(m_Commands[i]->GetName(), i);
+        for (size_t i = 0; i < m_Commands.size(); ++i) {
+            for (const std::string& alias : m_Commands[i]->GetAliases())
+                commandNames.Insert(alias, i);
+        }
+    });
+}
+
+const Argue::NameTrie& Argue::IArgParser::GetOptionNames() const
+{
+    return m_OptionNames.Get([this](NameTrie& optionNames) {
+        std::vector<std::vector<std::string>> longNames;
+        longNames.reserve(m_Options.size());
+
+        size_t namesCount = 0, namesLength = 0;
+        for (const IOption* opt : m_Options) {
+            longNames.push_back(opt->GetLongNames());
+            namesCount += longNames.back().size();
+            for (const std::string& name : longNames.back())
+                namesLength += name.size();
+        }
+
+        optionNames.Clear();
+        optionNames.Reserve(namesCount, namesLength);
+        for (size_t i = 0; i < longNames.size(); ++i) {
+            for (const std::string& name : longNames[i])
+                optionNames.Insert(name, i);
+        }
+    });
+}
+
+size_t Argue::IArgParser::FindShortOption(char shortName) const
+{
+    const std::vector<size_t>& shortOptions = m_ShortOptions.Get([this](std::vector<size_t>& entries) {
+        entries.assign(256, NameTrie::NPOS);
+        // Like when parsing, the first option with a given short name wins
+        for (size_t i = 0; i < m_Options.size(); ++i) {
+            const std::string& name = m_Options[i]->GetShortName();
+            if (name.empty())
+                continue;
+            size_t& entry = entries[static_cast<unsigned char>(name.front())];
+            if (name.length() > 1)
+                entry = NameTrie::AMBIGUOUS;
+            else if (entry == NameTrie::NPOS)
+                entry = i;
+        }
+    });
+    return shortOptions[static_cast<unsigned char>(shortName)];
+}
+
+const Argue::NameTrie& Argue::IArgParser::GetShortOptionNames() const
+{
+    return m_ShortOptionNames.Get([this](NameTrie& shortNames) {
+        size_t namesLength = 0;
+        for (const IOption* opt : m_Options)
+            namesLength += opt->GetShortName().size();
+
+        shortNames.Clear();
+        shortNames.Reserve(m_Options.size(), namesLength);
+        for (size_t i = 0; i < m_Options.size(); ++i) {
+            if (m_Options[i]->HasShortName())
+                shortNames.Insert(m_Options[i]->GetShortName(), i);
+        }
+    });
+}
+
+const std::vector<size_t>& Argue::IArgParser::GetCustomOptions() const
+{
+    return m_CustomOptions.Get([this](std::vector<size_t>& indices) {
+        const NameTrie& optionNames = GetOptionNames();
+        const NameTrie& shortNames = GetShortOptionNames();
+
+        indices.clear();
+        for (size_t i = 0; i < m_Options.size(); ++i) {
+            const IOption* opt = m_Options[i];
+            bool isShadowed = opt->HasShortName() && shortNames.Find(opt->GetShortName()) != i;
+            for (const std::string& name : opt->GetLongNames())
+                isShadowed = isShadowed || (!name.empty() && optionNames.Find(name) != i);
+            if (isShadowed || opt->ParsesCustomWords())
+                indices.push_back(i);
+        }
+    });
+}
+
+const std::vector<size_t>& Argue::IArgParser::GetCustomCommands() const
+{
+    return m_CustomCommands.Get([this](std::vector<size_t>& indices) {
+        indices.clear();
+        for (size_t i = 0; i < m_Commands.size(); ++i) {
+            if (m_Commands[i]->ParsesCustomWords())
+                indices.push_back(i);
+        }
+    });
+}
+
+Argue::IArgParser::~IArgParser()
+{
+    CachedHelp* cached = m_Help.load(std::memory_order_acquire);
+    while (cached != nullptr)
+        delete std::exchange(cached, cached->Next);
+}
+
+const std::string& Argue::IArgParser::GetHelp(
+        bool briefOptions,
+        bool briefSubcommands,
+        std::string_view indent,
+        bool indentOnWrap,
+        size_t maxParagraphWidth) const
+{
+    auto find = [&](const CachedHelp* cached) -> const CachedHelp* {
+        for (; cached != nullptr; cached = cached->Next) {
+            bool isCached =
+                cached->Version           == m_HelpVersion    &&
+                cached->BriefOptions      == briefOptions     &&
+                cached->BriefSubcommands  == briefSubcommands &&
+                cached->Indent            == indent           &&
+                cached->IndentOnWrap      == indentOnWrap     &&
+                cached->MaxParagraphWidth == maxParagraphWidth;
+            if (isCached)
+                return cached;
+        }
+        return nullptr;
+    };
+
+    CachedHelp* head = m_Help.load(std::memory_order_acquire);
+    if (const CachedHelp* cached = find(head))
+        return cached->Help;
+
+    // Threads which miss the same message build it at the same time, only the first one is kept
+    TextBuilder help(indent, indentOnWrap, maxParagraphWidth);
+    if (head != nullptr)
+        help.Reserve(head->Help.size());
+    WriteHelp(help, briefOptions, briefSubcommands);
+
+    std::unique_ptr<CachedHelp> built(new CachedHelp{
+        briefOptions, briefSubcommands, std::string(indent), indentOnWrap, maxParagraphWidth,
+        m_HelpVersion, help.Build(), head });
+    while (!m_Help.compare_exchange_weak(built->Next, built.get(), std::memory_order_release, std::memory_order_acquire)) {
+        if (const CachedHelp* cached = find(built->Next))
+            return cached->Help;
+    }
+    return built.release()->Help;
+}
+
+void Argue::IArgParser::WriteHint(ITextBuilder& hint) const
+{
+    hint.PutText(GetName());
+    for (const std::string& alias : m_Aliases) {
+        hint.PutText("|");
+        hint.PutText(alias);
+    }
+
+    if (m_Options.size() > 0) {
+        hint.PutText(" [...OPTIONS]");
+    }
+    if (m_Commands.size() > 0) {
+        hint.PutText(m_Hint.Get([this](std::string& text) {
+            text = " [";
+            text += m_Commands[0]->GetName();
+            for (size_t i = 1; i < m_Commands.size(); ++i) {
+                text += '|';
+                text += m_Commands[i]->GetName();
+            }
+            text += " ...]";
+        }));
+    }
+    if (m_Arguments.size() > 0) {
+        hint.PutText(" [--]");
+        for (const IPositionalArgument* arg : m_Arguments) {
+            hint.PutText(" ");
+            arg->WriteHint(hint);
+        }
+    }
+}
+
+namespace Argue
+{
+    // Returns "'a', 'b' or 'c'" with the names starting with `name`
+    static std::string ListNames(const NameTrie& names, std::string_view prefix, std::string_view name)
+    {
+        std::vector<NameTrie::Match> matches;
+        names.FindWithPrefix(name, matches);
+
+        std::string list;
+        for (size_t i = 0; i < matches.size(); ++i) {
+            if (i > 0) list += i+1 == matches.size() ? " or " : ", ";
+            list += s('\'', prefix, matches[i].Name, '\'');
+        }
+        return list;
+    }
+
+    /**
+     * A command as seen by ParseCommandWords() and WriteCommandHelp(), so that parser trees and schema images
+     * share them: TreeCommand views an IArgParser, ImageCommand a command of a SchemaView.
+     * Options, positional arguments and subcommands are addressed by their index within the command.
+     * Only the const methods are called to write help.
+     */
+    class ICommandSchema
+    {
+    public:
+        virtual ~ICommandSchema() = default;
+
+        virtual std::string_view GetName() const = 0;
+        virtual std::string_view GetDescription() const = 0;
+        virtual std::string_view GetPrefix() const = 0;
+        virtual std::string_view GetShortPrefix() const = 0;
+        virtual bool HasShortPrefix() const = 0;
+
+        virtual size_t GetOptionCount() const = 0;
+        virtual std::string_view GetOptionName(size_t idx) const = 0;
+        virtual std::string_view GetOptionShortName(size_t idx) const = 0;
+        virtual bool OptionHasMetaVar(size_t idx) const = 0;
+        virtual bool IsVarOptionalOption(size_t idx) const = 0;
+        virtual bool OptionHasValue(size_t idx) const = 0;
+
+        virtual size_t GetArgumentCount() const = 0;
+        virtual std::string_view GetArgumentMetaVar(size_t idx) const = 0;
+        virtual bool IsVariadicArgument(size_t idx) const = 0;
+        virtual bool ArgumentHasValue(size_t idx) const = 0;
+
+        virtual size_t GetSubCommandCount() const = 0;
+        virtual std::string_view GetSubCommandName(size_t idx) const = 0;
+
+        // Same as NameTrie::Find() and NameTrie::FindUnique() with the names of subcommands or options
+        virtual size_t FindSubCommand(std::string_view name) const = 0;
+        virtual size_t FindUniqueSubCommand(std::string_view name, std::string& match) const = 0;
+        virtual size_t FindOption(std::string_view name) const = 0;
+        virtual size_t FindUniqueOption(std::string_view name, std::string& match) const = 0;
+        // See IArgParser::FindShortOption()
+        virtual size_t FindShortOption(char shortName) const = 0;
+        // Same as NameTrie::FindPrefixesOf() with the long names or the short names of options
+        virtual void FindOptionPrefixesOf(std::string_view arg, std::vector<size_t>& indices) const = 0;
+        virtual void FindShortOptionPrefixesOf(std::string_view arg, std::vector<size_t>& indices) const = 0;
+        // See IArgParser::GetCustomOptions() and IArgParser::GetCustomCommands()
+        virtual void AppendCustomOptions(std::vector<size_t>& indices) const = 0;
+        virtual size_t GetCustomSubCommandCount() const = 0;
+        virtual size_t GetCustomSubCommand(size_t i) const = 0;
+        // Names are only listed and suggested within error messages
+        virtual const NameTrie& GetSubCommandNames() const = 0;
+        virtual const NameTrie& GetOptionNames() const = 0;
+        // Same as NameTrie::FindWithPrefix() with the names of subcommands or options
+        virtual void FindSubCommandsWithPrefix(std::string_view prefix, std::vector<NameTrie::Match>& matches) const = 0;
+        virtual void FindOptionsWithPrefix(std::string_view prefix, std::vector<NameTrie::Match>& matches) const = 0;
+        // See IOption::CompleteValue()
+        virtual void CompleteOptionValue(size_t idx, std::string_view prefix, std::vector<std::string>& candidates) const = 0;
+        // Same as CompleteCommandWords() with the subcommand
+        virtual void CompleteSubCommand(
+                size_t idx,
+                const std::vector<std::string_view>& words,
+                size_t wordIdx,
+                std::string_view word,
+                std::vector<std::string>& candidates) const = 0;
+
+        virtual void WriteHint(ITextBuilder& hint) const = 0;
+        virtual void WriteOptionHint(size_t idx, ITextBuilder& hint) const = 0;
+        virtual void WriteOptionHelp(size_t idx, ITextBuilder& help) const = 0;
+        virtual bool ArgumentHasDescription(size_t idx) const = 0;
+        virtual void WriteArgumentHelp(size_t idx, ITextBuilder& help) const = 0;
+        virtual void WriteSubCommandHint(size_t idx, ITextBuilder& hint) const = 0;
+        virtual void WriteSubCommandHelp(size_t idx, ITextBuilder& help, bool briefOptions, bool briefSubcommands) const = 0;
+
+    public:
+        virtual bool HasError() const = 0;
+        // Always returns false
+        virtual bool SetError(std::string&& errorMessage) = 0;
+        virtual bool PassThrough(std::string_view arg) = 0;
+        // Returns a view of `word` which lives as long as the values parsed from it
+        virtual std::string_view KeepWord(std::string&& word) = 0;
+        // Pops the word which was just parsed
+        virtual void PopWord(const ParseState& state, std::stack<std::string_view>& args) = 0;
+
+        virtual bool ParseOption(size_t idx, std::string_view arg, bool isShort) = 0;
+        virtual bool ParseArgument(size_t idx, std::string_view arg) = 0;
+        // Parses the remaining words with the subcommand, `args` starts with its name.
+        // If this returns false, either there was an error or the subcommand did not match.
+        virtual bool ParseSubCommand(size_t idx, std::stack<std::string_view>& args) = 0;
+        // Called once the command parsed its words, see CheckCommandValues()
+        virtual bool Finalize() = 0;
+    };
+
+    // Appends the candidates for `word` to `candidates`, see CompletionCommand.
+    // The words from `wordIdx` on are within `cmd`, they are walked without being parsed.
+    static void CompleteCommandWords(
+            const ICommandSchema& cmd,
+            const std::vector<std::string_view>& words,
+            size_t wordIdx,
+            std::string_view word,
+            std::vector<std::string>& candidates);
+
+    // An IArgParser as seen by the parse loop and the help layout
+    class TreeCommand final :
+        public ICommandSchema
+    {
+    public:
+        explicit TreeCommand(const IArgParser& parser) :
+            m_Schema(parser)
+        {}
+
+        explicit TreeCommand(IArgParser& parser) :
+            m_Schema(parser),
+            m_Parser(&parser)
+        {}
+
+        std::string_view GetName() const override { return m_Schema.GetName(); }
+        std::string_view GetDescription() const override { return m_Schema.GetDescription(); }
+        std::string_view GetPrefix() const override { return m_Schema.GetPrefix(); }
+        std::string_view GetShortPrefix() const override { return m_Schema.GetShortPrefix(); }
+        bool HasShortPrefix() const override { return m_Schema.HasShortPrefix(); }
+
+        size_t GetOptionCount() const override { return m_Schema.m_Options.size(); }
+        std::string_view GetOptionName(size_t idx) const override { return m_Schema.m_Options[idx]->GetName(); }
+        std::string_view GetOptionShortName(size_t idx) const override { return m_Schema.m_Options[idx]->GetShortName(); }
+        bool OptionHasMetaVar(size_t idx) const override { return m_Schema.m_Options[idx]->HasMetaVar(); }
+        bool IsVarOptionalOption(size_t idx) const override { return m_Schema.m_Options[idx]->IsVarOptional(); }
+        bool OptionHasValue(size_t idx) const override { return m_Schema.m_Options[idx]->HasValue(); }
+
+        size_t GetArgumentCount() const override { return m_Schema.m_Arguments.size(); }
+        std::string_view GetArgumentMetaVar(size_t idx) const override { return m_Schema.m_Arguments[idx]->GetMetaVar(); }
+        bool IsVariadicArgument(size_t idx) const override { return m_Schema.m_Arguments[idx]->IsVariadic(); }
+        bool ArgumentHasValue(size_t idx) const override { return m_Schema.m_Arguments[idx]->HasValue(); }
+
+        size_t GetSubCommandCount() const override { return m_Schema.m_Commands.size(); }
+        std::string_view GetSubCommandName(size_t idx) const override { return m_Schema.m_Commands[idx]->GetName(); }
+
+        size_t FindSubCommand(std::string_view name) const override { return m_Schema.GetCommandNames().Find(name); }
+        size_t FindUniqueSubCommand(std::string_view name, std::string& match) const override
+        {
+            return m_Schema.GetCommandNames().FindUnique(name, match);
+        }
+        size_t FindOption(std::string_view name) const override { return m_Schema.GetOptionNames().Find(name); }
+        size_t FindUniqueOption(std::string_view name, std::string& match) const override
+        {
+            return m_Schema.GetOptionNames().FindUnique(name, match);
+        }
+        size_t FindShortOption(char shortName) const override { return m_Schema.FindShortOption(shortName); }
+        void FindOptionPrefixesOf(std::string_view arg, std::vector<size_t>& indices) const override
+        {
+            m_Schema.GetOptionNames().FindPrefixesOf(arg, indices);
+        }
+        void FindShortOptionPrefixesOf(std::string_view arg, std::vector<size_t>& indices) const override
+        {
+            m_Schema.GetShortOptionNames().FindPrefixesOf(arg, indices);
+        }
+        void AppendCustomOptions(std::vector<size_t>& indices) const override
+        {
+            const std::vector<size_t>& customOptions = m_Schema.GetCustomOptions();
+            indices.insert(indices.end(), customOptions.begin(), customOptions.end());
+        }
+        size_t GetCustomSubCommandCount() const override { return m_Schema.GetCustomCommands().size(); }
+        size_t GetCustomSubCommand(size_t i) const override { return m_Schema.GetCustomCommands()[i]; }
+        const NameTrie& GetSubCommandNames() const override { return m_Schema.GetCommandNames(); }
+        const NameTrie& GetOptionNames() const override { return m_Schema.GetOptionNames(); }
+        void FindSubCommandsWithPrefix(std::string_view prefix, std::vector<NameTrie::Match>& matches) const override
+        {
+            m_Schema.GetCommandNames().FindWithPrefix(prefix, matches);
+        }
+        void FindOptionsWithPrefix(std::string_view prefix, std::vector<NameTrie::Match>& matches) const override
+        {
+            m_Schema.GetOptionNames().FindWithPrefix(prefix, matches);
+        }
+        void CompleteOptionValue(size_t idx, std::string_view prefix, std::vector<std::string>& candidates) const override
+        {
+            m_Schema.m_Options[idx]->CompleteValue(prefix, candidates);
+        }
+        void CompleteSubCommand(
+                size_t idx,
+                const std::vector<std::string_view>& words,
+                size_t wordIdx,
+                std::string_view word,
+                std::vector<std::string>& candidates) const override
+        {
+            CompleteCommandWords(TreeCommand(*m_Schema.m_Commands[idx]), words, wordIdx, word, candidates);
+        }
+
+        void WriteHint(ITextBuilder& hint) const override { m_Schema.WriteHint(hint); }
+        void WriteOptionHint(size_t idx, ITextBuilder& hint) const override { m_Schema.m_Options[idx]->WriteHint(hint); }
+        void WriteOptionHelp(size_t idx, ITextBuilder& help) const override { m_Schema.m_Options[idx]->WriteHelp(help); }
+        bool ArgumentHasDescription(size_t idx) const override { return m_Schema.m_Arguments[idx]->HasDescription(); }
+        void WriteArgumentHelp(size_t idx, ITextBuilder& help) const override { m_Schema.m_Arguments[idx]->WriteHelp(help); }
+        void WriteSubCommandHint(size_t idx, ITextBuilder& hint) const override { m_Schema.m_Commands[idx]->WriteHint(hint); }
+        void WriteSubCommandHelp(size_t idx, ITextBuilder& help, bool briefOptions, bool briefSubcommands) const override
+        {
+            m_Schema.m_Commands[idx]->WriteHelp(help, briefOptions, briefSubcommands);
+        }
+
+    public:
+        bool HasError() const override { return m_Schema.HasError(); }
+        bool SetError(std::string&& errorMessage) override { return m_Parser->SetError(std::move(errorMessage)); }
+        bool PassThrough(std::string_view arg) override { return m_Parser->PassThrough(arg); }
+        // Options copy what they keep, the word is only needed while it's parsed
+        std::string_view KeepWord(std::string&& word) override
+        {
+            m_Word = std::move(word);
+            return m_Word;
+        }
+        void PopWord(const ParseState& state, std::stack<std::string_view>& args) override { m_Parser->PopWord(state, args); }
+
+        bool ParseOption(size_t idx, std::string_view arg, bool isShort) override { return m_Parser->m_Options[idx]->Parse(arg, isShort); }
+        bool ParseArgument(size_t idx, std::string_view arg) override { return m_Parser->m_Arguments[idx]->Parse(arg); }
+        bool ParseSubCommand(size_t idx, std::stack<std::string_view>& args) override { return m_Parser->m_Commands[idx]->Parse(args); }
+        bool Finalize() override { return m_Parser->Finalize(); }
+
+    private:
+        const IArgParser& m_Schema;
+        IArgParser* m_Parser = nullptr; // Null if the parser is const
+        std::string m_Word;
+    };
+
+    // Same as IArgParser::CheckOptionsAndArguments()
+    static bool CheckCommandValues(ICommandSchema& cmd)
+    {
+        for (size_t i = 0; i < cmd.GetOptionCount(); ++i) {
+            if (!cmd.OptionHasValue(i)) {
+                return cmd.SetError(s("Missing option '", cmd.GetPrefix(), cmd.GetOptionName(i), "' to '", cmd.GetName(), "'."));
+            }
+        }
+
+        for (size_t i = 0; i < cmd.GetArgumentCount(); ++i) {
+            if (!cmd.ArgumentHasValue(i)) {
+                return cmd.SetError(s("Missing argument '", cmd.GetArgumentMetaVar(i), "' to '", cmd.GetName(), "'."));
+            }
+        }
+
+        return true;
+    }
+
+    // Parses `arg` as the current positional argument.
+    // `mayBeCommand` if it did not match any subcommand, which may then be suggested.
+    static bool ParseCommandPositional(ICommandSchema& cmd, ParseState& state, std::string_view arg, bool mayBeCommand)
+    {
+        if (state.PositionalIdx >= cmd.GetArgumentCount()) {
+            if (cmd.PassThrough(arg))
+                return true;
+            return cmd.SetError(s(
+                "Unexpected positional argument '", arg, "'.",
+                BuildSuggestion(cmd.GetSubCommandNames(), "", mayBeCommand ? arg : "")
             ));
         }
-    } else {
-        if (m_Parser.HasShortPrefix() && HasShortName()) {
-            hint.PutText(s(
-                m_Parser.GetPrefix(), GetName(), ", ",
-                m_Parser.GetShortPrefix(), GetShortName()
-            ));
-        } else {
-            hint.PutText(s(
-                m_Parser.GetPrefix(), GetName()
-            ));
+
+        const size_t idx = state.PositionalIdx;
+        if (!cmd.ParseArgument(idx, arg))
+            return false;
+        if (!cmd.IsVariadicArgument(idx))
+            ++state.PositionalIdx;
+        return true;
+    }
+
+    // Parses `arg` as a single byte short name or a cluster of them, see IArgParser::FindShortOption().
+    // Returns false if some name is not a single byte, or if an option failed.
+    static bool ParseCommandShortOptions(ICommandSchema& cmd, std::string_view arg)
+    {
+        const size_t firstIdx = cmd.FindShortOption(arg.front());
+        if (firstIdx >= cmd.GetOptionCount())
+            return false;
+        if (cmd.ParseOption(firstIdx, arg, true))
+            return true;
+        if (cmd.HasError())
+            return false;
+
+        // A cluster of single byte short names (e.g. -xvzf), only the last one may take a value (e.g. -vj8).
+        // It is checked before parsing so that a malformed cluster does not set any option.
+        size_t clusterLength = 0;
+        while (clusterLength < arg.length()) {
+            const size_t idx = cmd.FindShortOption(arg[clusterLength]);
+            if (idx >= cmd.GetOptionCount())
+                return false;
+            ++clusterLength;
+            if (cmd.OptionHasMetaVar(idx))
+                break;
+        }
+
+        for (size_t i = 0; i < clusterLength; ++i) {
+            const size_t idx = cmd.FindShortOption(arg[i]);
+            const bool isLast = i+1 == clusterLength;
+            if (!cmd.ParseOption(idx, isLast ? arg.substr(i) : arg.substr(i, 1), true))
+                return false;
+        }
+        return true;
+    }
+
+    // Parses the remaining words of the command line from `state`, in which `cmd` is the innermost command
+    static bool ParseCommandWords(ICommandSchema& cmd, ParseState& state, std::stack<std::string_view>& args)
+    {
+        const std::string_view prefix = cmd.GetPrefix();
+        const std::string_view shortPrefix = cmd.GetShortPrefix();
+        const bool arePrefixesTheSame = shortPrefix == prefix;
+        const size_t optionCount = cmd.GetOptionCount();
+
+        for (; !args.empty(); cmd.PopWord(state, args)) {
+            std::string_view argWithPrefix = args.top();
+            std::string_view arg = argWithPrefix;
+
+            if (state.IsParsingPositionals) {
+                if (!ParseCommandPositional(cmd, state, arg, false))
+                    return false;
+                continue;
+            }
+
+            if (arg == "--") {
+                state.IsParsingPositionals = true;
+                continue;
+            }
+
+            bool isShortPrefix = false;
+            if (arg.starts_with(prefix)) {
+                arg.remove_prefix(prefix.length());
+                isShortPrefix = false;
+            } else if (cmd.HasShortPrefix() && arg.starts_with(shortPrefix)) {
+                arg.remove_prefix(shortPrefix.length());
+                isShortPrefix = true;
+            } else {
+                // Try Parse Commands, names and aliases are looked up first.
+                // Without positional arguments, unique prefixes of names are also accepted.
+                std::string cmdName;
+                size_t cmdIdx = cmd.FindSubCommand(arg);
+                if (cmdIdx == NameTrie::NPOS && cmd.GetArgumentCount() == 0) {
+                    cmdIdx = cmd.FindUniqueSubCommand(arg, cmdName);
+                    if (cmdIdx == NameTrie::AMBIGUOUS) {
+                        return cmd.SetError(s(
+                            "Ambiguous command '", argWithPrefix, "', it may be ",
+                            ListNames(cmd.GetSubCommandNames(), "", arg), "."
+                        ));
+                    }
+                }
+
+                if (cmdIdx != NameTrie::NPOS) {
+                    // The command only knows its own name
+                    args.pop();
+                    args.push(cmd.GetSubCommandName(cmdIdx));
+                    if (cmd.ParseSubCommand(cmdIdx, args))
+                        return cmd.Finalize();
+                    if (cmd.HasError())
+                        return false;
+                    args.pop();
+                    args.push(argWithPrefix);
+                }
+
+                // Commands may parse arguments which are not their names
+                for (size_t i = 0; i < cmd.GetCustomSubCommandCount(); ++i) {
+                    if (cmd.ParseSubCommand(cmd.GetCustomSubCommand(i), args))
+                        return cmd.Finalize();
+                    if (cmd.HasError())
+                        return false;
+                }
+
+                // Not a command, this and the following words are positional arguments
+                state.IsParsingPositionals = true;
+                if (!ParseCommandPositional(cmd, state, arg, true))
+                    return false;
+                continue;
+            }
+
+            // Parse options, long names and aliases are looked up first
+            bool hasParsedOption = false;
+            if (isShortPrefix && !arePrefixesTheSame && !arg.empty()) {
+                hasParsedOption = ParseCommandShortOptions(cmd, arg);
+                if (cmd.HasError())
+                    return false;
+            }
+
+            const std::string_view longName = arg.substr(0, arg.find('='));
+            size_t optIdx = NameTrie::NPOS;
+            if (!isShortPrefix) {
+                optIdx = cmd.FindOption(longName);
+                if (optIdx != NameTrie::NPOS)
+                    hasParsedOption = cmd.ParseOption(optIdx, arg, false);
+                if (cmd.HasError())
+                    return false;
+            }
+            const bool isExactName = optIdx != NameTrie::NPOS;
+
+            // Unique prefixes of long names, the option is given its full name.
+            // If prefixes are the same, short names are preferred.
+            std::string_view abbreviatedArg;
+            if (!hasParsedOption && !isShortPrefix && optIdx == NameTrie::NPOS && !longName.empty()) {
+                std::string fullName;
+                optIdx = cmd.FindUniqueOption(longName, fullName);
+                if (optIdx < optionCount)
+                    abbreviatedArg = cmd.KeepWord(s(fullName, arg.substr(longName.size())));
+                if (optIdx < optionCount && !arePrefixesTheSame) {
+                    hasParsedOption = cmd.ParseOption(optIdx, abbreviatedArg, false);
+                    if (cmd.HasError())
+                        return false;
+                }
+            }
+
+            // Options may parse arguments which start with one of their names (e.g. a short name
+            //  followed by a value), or which are not their names at all if they declare it.
+            // Only those are tried, in the order in which they were added.
+            std::vector<size_t> candidates;
+            if (!hasParsedOption) {
+                cmd.AppendCustomOptions(candidates);
+                if (!isShortPrefix || arePrefixesTheSame)
+                    cmd.FindOptionPrefixesOf(arg, candidates);
+                if (isShortPrefix || arePrefixesTheSame)
+                    cmd.FindShortOptionPrefixesOf(arg, candidates);
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            }
+
+            for (size_t i = 0; !hasParsedOption && i < candidates.size(); ++i) {
+                if (cmd.ParseOption(candidates[i], arg, isShortPrefix)) {
+                    hasParsedOption = true;
+                    break;
+                }
+
+                if (cmd.HasError())
+                    return false;
+
+                // If prefixes are equal, long prefix is preferred.
+                // Try parsing again but as if the short prefix was used.
+                if (arePrefixesTheSame) {
+                    if (cmd.ParseOption(candidates[i], arg, !isShortPrefix)) {
+                        hasParsedOption = true;
+                        break;
+                    }
+
+                    if (cmd.HasError())
+                        return false;
+                }
+            }
+
+            if (!hasParsedOption && arePrefixesTheSame && optIdx < optionCount && !abbreviatedArg.empty()) {
+                hasParsedOption = cmd.ParseOption(optIdx, abbreviatedArg, false);
+                if (cmd.HasError())
+                    return false;
+            }
+
+            if (!hasParsedOption && optIdx == NameTrie::AMBIGUOUS) {
+                // Ambiguous prefixes may be options of the wrapped program too
+                if (!isExactName && cmd.PassThrough(argWithPrefix))
+                    continue;
+                return cmd.SetError(s(
+                    "Ambiguous option '", argWithPrefix, "', it may be ",
+                    ListNames(cmd.GetOptionNames(), prefix, longName), "."
+                ));
+            }
+
+            if (!hasParsedOption) {
+                // Known options are not passed through without their value,
+                //  unique prefixes of their names may be options of the wrapped program though
+                if (!isExactName && cmd.PassThrough(argWithPrefix))
+                    continue;
+                // The word names a known option which rejected it, e.g. without its value
+                if (optIdx < optionCount) {
+                    if (longName.length() < arg.length()) {
+                        return cmd.SetError(s(
+                            "Unexpected value for '", prefix, longName, "', got '", arg.substr(longName.length() + 1), "'."
+                        ));
+                    }
+                    return cmd.SetError(s("Missing value for '", argWithPrefix, "'."));
+                }
+                // Short names are too short to be told apart by their edit distance
+                return cmd.SetError(s(
+                    "Unknown option '", argWithPrefix, "'.",
+                    BuildSuggestion(cmd.GetOptionNames(), prefix,
+                        isShortPrefix && !arePrefixesTheSame ? std::string_view() : longName)
+                ));
+            }
+        }
+
+        return cmd.Finalize();
+    }
+}
+
+void Argue::IArgParser::WriteHelp(ITextBuilder& help, bool briefOptions, bool briefSubcommands) const
+{
+    WriteCommandHelp(TreeCommand(*this), help, briefOptions, briefSubcommands);
+}
+
+bool Argue::IArgParser::SetErrorWithSuggestion(
+        std::string&& errorMessage,
+        const NameTrie& names,
+        std::string_view prefix,
+        std::string_view unknown)
+{
+    errorMessage += BuildSuggestion(names, prefix, unknown);
+    return SetError(std::forward<std::string>(errorMessage));
+}
+
+bool Argue::IArgParser::Parse(std::stack<std::string_view> args)
+{
+    if (args.top() != GetName())
+        return false;
+
+    m_WasUsed = true;
+    ParseState state;
+    state.Parser = this;
+    PopWord(state, args);
+    return ParseWords(state, args);
+}
+
+void Argue::IArgParser::PopWord(const ParseState& state, std::stack<std::string_view>& args)
+{
+    args.pop();
+    if (IParseObserver* observer = GetObserver())
+        observer->OnWordParsed(state);
+}
+
+bool Argue::IArgParser::ParseWords(ParseState& state, std::stack<std::string_view>& args)
+{
+    TreeCommand cmd(*this);
+    return ParseCommandWords(cmd, state, args);
+}
+
+bool Argue::IArgParser::Finalize()
+{
+    // Sources may give other values than the last time, e.g. a reloaded file
+    ResetFallbacks();
+    for (IValueSource* source : m_Sources) {
+        if (!source->Resolve(*this))
+            return false;
+    }
+
+    if (!CheckOptionsAndArguments() || HasError())
+        return false;
+
+    for (IConfigBinding* binding : m_Bindings)
+        binding->Resolve(*this);
+    return true;
+}
+
+void Argue::IArgParser::ResetFallbacks()
+{
+    for (IOption* opt : m_Options) {
+        if (opt->IsFallback())
+            opt->Reset();
+    }
+}
+
+bool Argue::IArgParser::CheckOptionsAndArguments()
+{
+    TreeCommand cmd(*this);
+    return CheckCommandValues(cmd);
+}
+
+std::string Argue::FlagOption::BuildHint() const
+{
+    const IArgParser& parser = GetParser();
+    if (parser.HasShortPrefix() && HasShortName()) {
+        return s(parser.GetPrefix(), GetName(), ", ", parser.GetShortPrefix(), GetShortName());
+    } else {
+        return s(parser.GetPrefix(), GetName());
+    }
+}
+
+void Argue::FlagOption::WriteHelp(ITextBuilder& help) const
+{
+    const IArgParser& parser = GetParser();
+
+    WriteHint(help);
+    help.PutText(", ");
+    if (parser.HasShortPrefix() && HasShortName())
+        help.NewLine();
+    help.PutText(s(GetParser().GetPrefix(), "no-", GetName()));
+
+    if (HasDescription()) {
+        help.NewLine();
+        help.Indent();
+        help.PutText(GetDescription());
+        help.DeIndent();
+    }
+}
+
+std::vector<std::string> Argue::FlagOption::GetLongNames() const
+{
+    std::vector<std::string> names = IOption::GetLongNames();
+    const size_t nameCount = names.size();
+    for (size_t i = 0; i < nameCount; ++i)
+        names.push_back(s("no-", names[i]));
+    return names;
+}
+
+bool Argue::FlagOption::ParseArg(std::string_view arg, bool isShort)
+{
+    const bool hasConsumedName = ConsumeName(arg, isShort);
+    bool flag = false;
+    if (!ParseFlagArg(arg, isShort, hasConsumedName, [this](std::string_view name) { return IsLongName(name); }, flag))
+        return false;
+    SetValue(flag);
+    return true;
+}
+
+bool Argue::FlagOption::ParseValue(std::string_view val)
+{
+    if (val == "1" || val == "true" || val == "yes" || val == "on") {
+        SetValue(true);
+        return true;
+    }
+    if (val == "0" || val == "false" || val == "no" || val == "off") {
+        SetValue(false);
+        return true;
+    }
+    return SetError(s("Expected one of {1,true,yes,on,0,false,no,off} for '", GetParser().GetPrefix(), GetName(), "', got '", val, "'."));
+}
+
+bool Argue::IntOption::ParseValue(std::string_view val)
+{
+    std::string error;
+    if (!ParseIntValue(val, GetParser().GetPrefix(), GetName(), m_Value, error))
+        return SetError(std::move(error));
+    return true;
+}
+
+bool Argue::StrOption::ParseValue(std::string_view val)
+{
+    m_Value = val;
+    return true;
+}
+
+std::string Argue::ChoiceOption::BuildHint() const
+{
+    const IArgParser& parser = GetParser();
+    std::string choices = GetChoiceString();
+    if (parser.HasShortPrefix() && HasShortName()) {
+        return s(
+            parser.GetPrefix(), GetName(), '=', choices, ", ",
+            parser.GetShortPrefix(), GetShortName(), choices
+        );
+    } else {
+        return s(
+            parser.GetPrefix(), GetName(), '=', choices
+        );
+    }
+}
+
+bool Argue::ChoiceOption::ParseValue(std::string_view val)
+{
+    std::string error;
+    const auto getChoice = [this](size_t i) -> std::string_view { return m_Choices[i]; };
+    if (!ParseChoiceValue(val, m_Choices.size(), getChoice, GetParser().GetPrefix(), GetName(), m_ValueIdx, error))
+        return SetError(std::move(error));
+    return true;
+}
+
+void Argue::ChoiceOption::CompleteValue(std::string_view prefix, std::vector<std::string>& candidates) const
+{
+    const NameTrie& choiceNames = m_ChoiceNames.Get([this](NameTrie& names) {
+        names.Clear();
+        for (size_t i = 0; i < m_Choices.size(); ++i)
+            names.Insert(m_Choices[i], i);
+    });
+
+    std::vector<NameTrie::Match> matches;
+    choiceNames.FindWithPrefix(prefix, matches);
+    for (auto& match : matches)
+        candidates.push_back(std::move(match.Name));
+}
+
+std::string Argue::ChoiceOption::GetChoiceString() const
+{
+    return BuildChoiceString(m_Choices.size(), [this](size_t i) -> std::string_view { return m_Choices[i]; });
+}
+
+bool Argue::CollectionOption::ParseValue(std::string_view val)
+{
+    std::string error;
+    if (!CheckCollectionValue(val, m_AcceptEmptyValues, GetParser().GetPrefix(), GetName(), error))
+        return SetError(std::move(error));
+    m_Value.emplace_back(val);
+    return true;
+}
+
+bool Argue::CollectionOption::RestoreValue(size_t parseCount)
+{
+    // Each parse adds one value
+    if (parseCount > m_Value.size())
+        return false;
+    m_Value.resize(parseCount);
+    return true;
+}
+
+bool Argue::StrArgument::ParseArg(std::string_view arg)
+{
+    m_Value = arg;
+    return true;
+}
+
+bool Argue::StrVarArgument::ParseArg(std::string_view arg)
+{
+    m_Value.emplace_back(arg);
+    return true;
+}
+
+bool Argue::StrVarArgument::RestoreValue(size_t parseCount)
+{
+    if (parseCount > m_Value.size())
+        return false;
+    m_Value.resize(parseCount);
+    return true;
+}
+
+Argue::Environment::Environment()
+{
+#if defined(ARGUE_POSIX)
+    Index(environ);
+#elif defined(_WIN32)
+    char** entries = nullptr;
+    if (_get_environ(&entries) == 0)
+        Index(entries);
+#endif
+}
+
+Argue::Environment::Environment(const char* const* entries)
+{
+    Index(entries);
+}
+
+void Argue::Environment::Index(const char* const* entries)
+{
+    if (entries == nullptr)
+        return;
+
+    size_t count = 0;
+    while (entries[count] != nullptr)
+        ++count;
+    m_Variables.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const std::string_view entry = entries[i];
+        const size_t equals = entry.find('=');
+        // The first one is kept like getenv() does
+        if (equals != std::string_view::npos)
+            m_Variables.emplace(entry.substr(0, equals), entry.substr(equals+1));
+    }
+}
+
+bool Argue::Environment::Find(std::string_view name, std::string_view& value) const
+{
+    auto it = m_Variables.find(name);
+    if (it == m_Variables.end())
+        return false;
+    value = it->second;
+    return true;
+}
+
+Argue::EnvBinding& Argue::EnvBinding::BindAll(std::string_view prefix)
+{
+    for (const IOption* opt : GetParser().GetOptions()) {
+        std::string variable(prefix);
+        for (char ch : opt->GetName()) {
+            if (ch >= 'a' && ch <= 'z') {
+                variable += static_cast<char>(ch - 'a' + 'A');
+            } else {
+                const bool isAlnum = (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9');
+                variable += isAlnum ? ch : '_';
+            }
+        }
+        Bind(*opt, variable);
+    }
+    return *this;
+}
+
+bool Argue::EnvBinding::Resolve(IArgParser& parser)
+{
+    const std::vector<IOption*>& options = parser.GetOptions();
+    std::string_view value;
+    for (const Variable& variable : m_Variables) {
+        IOption& opt = *options[variable.Option];
+        if (opt.WasParsed() || !m_Env.Find(variable.Name, value) || value.empty())
+            continue;
+        if (!opt.ParseFallback(value))
+            return parser.SetError(s("Environment variable '", variable.Name, "': ", parser.GetError()));
+    }
+    return true;
+}
+
+void Argue::HelpCommand::operator()(ITextBuilder& help) const
+{
+    std::string pathUntilLast;
+    std::stack<std::string_view> helpPath;
+    {
+        const auto& rawPath = *m_HelpFor;
+        for (size_t i = rawPath.size(); i > 0; --i)
+            helpPath.emplace(rawPath[i-1]);
+    }
+
+    const IArgParser* currentSubcommand = &m_Command.GetParent();
+    while (!helpPath.empty()) {
+        std::string_view cmdToMatch = helpPath.top();
+        bool hasFoundCommand = false;
+        for (const IArgParser* sub : currentSubcommand->GetSubCommands()) {
+            if (sub->GetName() == cmdToMatch) {
+                hasFoundCommand = true;
+                currentSubcommand = sub;
+                break;
+            }
+        }
+
+        if (!hasFoundCommand) {
+            help.PutText(s("Could not find help for '", pathUntilLast, cmdToMatch, "'."));
+            help.NewLine();
+            return;
+        }
+
+        helpPath.pop();
+        if (!helpPath.empty()) {
+            pathUntilLast += cmdToMatch;
+            pathUntilLast += " ";
+        }
+    }
+
+    bool briefOptions = false;
+    bool briefSubcommands = *m_PrintType == "brief";
+
+    help.PutText(pathUntilLast);
+    currentSubcommand->WriteHelp(help, briefOptions, briefSubcommands);
+}
+
+namespace Argue
+{
+    // The completion candidate for `name`, one of the long names of the option at `optIdx`
+    static std::string GetLongOptionCandidate(const ICommandSchema& cmd, size_t optIdx, std::string_view name)
+    {
+        // Options which require a value only accept it after '='
+        bool needsValue = cmd.OptionHasMetaVar(optIdx) && !cmd.IsVarOptionalOption(optIdx) && name == cmd.GetOptionName(optIdx);
+        return s(cmd.GetPrefix(), name, needsValue ? "=" : "");
+    }
+
+    static void CompleteCommandWords(
+            const ICommandSchema& cmd,
+            const std::vector<std::string_view>& words,
+            size_t wordIdx,
+            std::string_view word,
+            std::vector<std::string>& candidates)
+    {
+        // Walk the command line like IArgParser::Parse() does
+        const std::string_view prefix = cmd.GetPrefix();
+        const std::string_view shortPrefix = cmd.GetShortPrefix();
+        for (; wordIdx < words.size(); ++wordIdx) {
+            const std::string_view arg = words[wordIdx];
+            if (arg == "--" || !(arg.starts_with(prefix) || (cmd.HasShortPrefix() && arg.starts_with(shortPrefix)))) {
+                const size_t cmdIdx = arg == "--" ? NameTrie::NPOS : cmd.FindSubCommand(arg);
+                if (cmdIdx == NameTrie::NPOS) {
+                    // Positional arguments follow, they can't be completed
+                    return;
+                }
+                return cmd.CompleteSubCommand(cmdIdx, words, wordIdx+1, word, candidates);
+            }
+        }
+
+        std::vector<NameTrie::Match> matches;
+        if (word.starts_with(prefix) || (!word.empty() && prefix.starts_with(word))) {
+            std::string_view name = word.substr(std::min(prefix.size(), word.size()));
+            size_t valueIdx = name.find('=');
+            if (valueIdx != std::string_view::npos) {
+                size_t optIdx = cmd.FindOption(name.substr(0, valueIdx));
+                if (optIdx != NameTrie::NPOS) {
+                    std::vector<std::string> values;
+                    cmd.CompleteOptionValue(optIdx, name.substr(valueIdx+1), values);
+                    for (const std::string& value : values)
+                        candidates.push_back(s(prefix, name.substr(0, valueIdx+1), value));
+                }
+            } else {
+                cmd.FindOptionsWithPrefix(name, matches);
+                for (const NameTrie::Match& match : matches)
+                    candidates.push_back(GetLongOptionCandidate(cmd, match.Index, match.Name));
+            }
+        }
+
+        if (cmd.HasShortPrefix() && word.starts_with(shortPrefix)) {
+            std::string_view shortName = word.substr(shortPrefix.size());
+            for (size_t i = 0; i < cmd.GetOptionCount(); ++i) {
+                const std::string_view optShortName = cmd.GetOptionShortName(i);
+                if (!optShortName.empty() && optShortName.starts_with(shortName))
+                    candidates.push_back(s(shortPrefix, optShortName));
+            }
+        }
+
+        if (!word.starts_with(prefix) && !(cmd.HasShortPrefix() && word.starts_with(shortPrefix))) {
+            matches.clear();
+            cmd.FindSubCommandsWithPrefix(word, matches);
+            for (NameTrie::Match& match : matches)
+                candidates.push_back(std::move(match.Name));
+        }
+    }
+}
+
+bool Argue::CompletionCommand::Parse(int argc, const char** argv)
+{
+    m_IsRequested = false;
+    m_Words.clear();
+    m_Word = {};
+
+    if (argc < 3 || argv[1] != m_Command)
+        return false;
+    m_IsRequested = true;
+
+    std::string_view rawIndex = argv[2];
+    size_t index = 0;
+    auto result = std::from_chars(rawIndex.data(), rawIndex.data() + rawIndex.size(), index, 10);
+    if (result.ptr != rawIndex.data() + rawIndex.size() || index < 1) {
+        // Nothing to complete, the request was still handled
+        index = 0;
+    }
+
+    const int wordCount = argc-3;
+    for (int i = 0; i < wordCount && static_cast<size_t>(i) < index; ++i)
+        m_Words.emplace_back(argv[3+i]);
+    if (index > 0 && index < static_cast<size_t>(wordCount))
+        m_Word = argv[3+index];
+
+    // The word being completed was not found (e.g. the index is out of range)
+    if (m_Words.size() != index)
+        m_Words.clear();
+    return true;
+}
+
+void Argue::CompletionCommand::operator()(ITextBuilder& candidates) const
+{
+    for (const std::string& candidate : GetCandidates()) {
+        candidates.PutText(candidate);
+        candidates.NewLine();
+    }
+}
+
+std::vector<std::string> Argue::CompletionCommand::GetCandidates() const
+{
+    std::vector<std::string> candidates;
+    if (m_Words.empty())
+        return candidates;
+
+    // The program's name is skipped
+    if (m_Schema != nullptr) {
+        m_Schema->Complete(m_Words, m_Word, candidates);
+    } else {
+        CompleteCommandWords(TreeCommand(*m_Parser), m_Words, 1, m_Word, candidates);
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    return candidates;
+}
+
+namespace Argue
+{
+    // One entry per parser, lists are separated by spaces
+    struct CompletionTables
+    {
+        std::vector<std::string> CommandNames;
+        std::vector<std::string> CommandNodes; // The entries of the commands in CommandNames
+        std::vector<std::string> Options;
+        std::vector<std::string> Values; // --option=value candidates
+    };
+
+    // Parsers are numbered breadth first starting from `firstNode`, the root being the first one
+    static void CollectCompletionTables(const IArgParser& root, size_t firstNode, CompletionTables& tables)
+    {
+        std::vector<const IArgParser*> parsers{ &root };
+        for (size_t i = 0; i < parsers.size(); ++i) {
+            const IArgParser& parser = *parsers[i];
+
+            std::string names, nodes;
+            for (const IArgParser* cmd : parser.GetSubCommands()) {
+                const std::string node = std::to_string(firstNode + parsers.size());
+                for (size_t nameIdx = 0; nameIdx <= cmd->GetAliases().size(); ++nameIdx) {
+                    if (!names.empty()) {
+                        names += ' ';
+                        nodes += ' ';
+                    }
+                    names += nameIdx == 0 ? cmd->GetName() : cmd->GetAliases()[nameIdx-1];
+                    nodes += node;
+                }
+                parsers.push_back(cmd);
+            }
+
+            const TreeCommand cmd(parser);
+            std::string options, values;
+            std::vector<std::string> optionValues;
+            for (size_t optIdx = 0; optIdx < parser.GetOptions().size(); ++optIdx) {
+                const IOption* opt = parser.GetOptions()[optIdx];
+                for (const std::string& name : opt->GetLongNames()) {
+                    if (!options.empty()) options += ' ';
+                    options += GetLongOptionCandidate(cmd, optIdx, name);
+                }
+                if (parser.HasShortPrefix() && opt->HasShortName()) {
+                    if (!options.empty()) options += ' ';
+                    options += parser.GetShortPrefix();
+                    options += opt->GetShortName();
+                }
+
+                optionValues.clear();
+                opt->CompleteValue("", optionValues);
+                for (const std::string& value : optionValues) {
+                    if (!values.empty()) values += ' ';
+                    values += s(parser.GetPrefix(), opt->GetName(), '=', value);
+                }
+            }
+
+            tables.CommandNames.push_back(std::move(names));
+            tables.CommandNodes.push_back(std::move(nodes));
+            tables.Options.push_back(std::move(options));
+            tables.Values.push_back(std::move(values));
+        }
+    }
+
+    // Single-quotes text for POSIX shells, or for fish if `isFish`
+    static void AppendQuoted(std::string& script, std::string_view text, bool isFish)
+    {
+        script += '\'';
+        for (char ch : text) {
+            if (ch == '\'') {
+                script += isFish ? "\\'" : "'\\''";
+            } else if (ch == '\\' && isFish) {
+                script += "\\\\";
+            } else script += ch;
+        }
+        script += '\'';
+    }
+
+    static void AppendList(std::string& script, const std::vector<std::string>& list, bool isFish)
+    {
+        for (const std::string& item : list) {
+            script += ' ';
+            AppendQuoted(script, item, isFish);
+        }
+    }
+}
+
+std::string Argue::GenerateCompletionScript(const IArgParser& parser, std::string_view command, CompletionShell shell)
+{
+    const bool isFish = shell == CompletionShell::Fish;
+
+    // Used within function and variable names
+    std::string id;
+    for (char ch : command) {
+        bool isAlnum = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9');
+        id += isAlnum ? ch : '_';
+    }
+
+    CompletionTables tables;
+    // Bash arrays start from 0, fish lists from 1
+    CollectCompletionTables(parser, isFish ? 1 : 0, tables);
+
+    std::string script = s("# Completion for ", command, ", generated by Argue. It does not run ", command, ".\n");
+    if (isFish) {
+        script += s("function __argue_", id, "_starts_with -a word prefix\n");
+        script += "    set -l head (string sub -l (string length -- \"$prefix\") -- \"$word\")\n"
+                  "    test \"$head\" = \"$prefix\"\n"
+                  "end\n\n";
+
+        script += s("function __argue_", id, "_complete\n");
+        script += "    set -l prefix ";       AppendQuoted(script, parser.GetPrefix(), true);
+        script += "\n    set -l short_prefix "; AppendQuoted(script, parser.GetShortPrefix(), true);
+        script += "\n    set -l command_names"; AppendList(script, tables.CommandNames, true);
+        script += "\n    set -l command_nodes"; AppendList(script, tables.CommandNodes, true);
+        script += "\n    set -l options";       AppendList(script, tables.Options, true);
+        script += "\n    set -l values";        AppendList(script, tables.Values, true);
+        script += s(
+            "\n"
+            "    set -l words (commandline -opc)\n"
+            "    set -l cur (commandline -ct)\n"
+            "    set -e words[1]\n"
+            "    set -l node 1\n"
+            "    for word in $words\n"
+            "        test \"$word\" = --; and return\n"
+            "        if __argue_", id, "_starts_with \"$word\" \"$prefix\"\n"
+            "            or begin; test -n \"$short_prefix\"; and __argue_", id, "_starts_with \"$word\" \"$short_prefix\"; end\n"
+            "            continue\n"
+            "        end\n"
+            "        set -l names (string split -n ' ' -- $command_names[$node])\n"
+            "        set -l nodes (string split -n ' ' -- $command_nodes[$node])\n"
+            "        set -l next\n"
+            "        for i in (seq (count $names))\n"
+            "            if test \"$names[$i]\" = \"$word\"\n"
+            "                set next $nodes[$i]\n"
+            "                break\n"
+            "            end\n"
+            "        end\n"
+            "        test -z \"$next\"; and return\n"
+            "        set node $next\n"
+            "    end\n"
+            "    if __argue_", id, "_starts_with \"$cur\" \"$prefix\"; and string match -q -- '*=*' \"$cur\"\n"
+            "        string split -n ' ' -- $values[$node]\n"
+            "    else if __argue_", id, "_starts_with \"$cur\" \"$prefix\"\n"
+            "        or begin; test -n \"$short_prefix\"; and __argue_", id, "_starts_with \"$cur\" \"$short_prefix\"; end\n"
+            "        or begin; test -n \"$cur\"; and __argue_", id, "_starts_with \"$prefix\" \"$cur\"; end\n"
+            "        string split -n ' ' -- $options[$node]\n"
+            "    else\n"
+            "        string split -n ' ' -- $command_names[$node]\n"
+            "    end\n"
+            "end\n\n"
+            "complete -c "
+        );
+        AppendQuoted(script, command, true);
+        script += s(" -f -a '(__argue_", id, "_complete)'\n");
+        return script;
+    }
+
+    if (shell == CompletionShell::Zsh)
+        script += "autoload -U +X bashcompinit && bashcompinit\n";
+
+    const std::string var = s("_argue_", id);
+    script += s(var, "_prefix=");         AppendQuoted(script, parser.GetPrefix(), false);
+    script += s("\n", var, "_short_prefix="); AppendQuoted(script, parser.GetShortPrefix(), false);
+    script += s("\n", var, "_command_names=("); AppendList(script, tables.CommandNames, false);
+    script += s(" )\n", var, "_command_nodes=("); AppendList(script, tables.CommandNodes, false);
+    script += s(" )\n", var, "_options=(");       AppendList(script, tables.Options, false);
+    script += s(" )\n", var, "_values=(");        AppendList(script, tables.Values, false);
+    script += s(
+        " )\n\n",
+        "# Appends the words of the list $1 which start with $2 to COMPREPLY.\n"
+        "# Words are split without being expanded, they may contain any character but spaces.\n",
+        var, "_filter() {\n"
+        "    local list=\"$1 \" word\n"
+        "    while [[ -n \"$list\" ]]; do\n"
+        "        word=\"${list%% *}\"\n"
+        "        list=\"${list#* }\"\n"
+        "        [[ -n \"$word\" && \"$word\" == \"$2\"* ]] && COMPREPLY+=(\"$word\")\n"
+        "    done\n"
+        "}\n\n",
+        var, "() {\n"
+        "    # Bash splits words on '=', join them back\n"
+        "    local -a words=()\n"
+        "    local i word join=\n"
+        "    for ((i = 1; i <= COMP_CWORD; ++i)); do\n"
+        "        word=\"${COMP_WORDS[i]}\"\n"
+        "        if [[ ${#words[@]} -gt 0 && ( \"$word\" == = || -n \"$join\" ) ]]; then\n"
+        "            words[${#words[@]}-1]+=\"$word\"\n"
+        "        else\n"
+        "            words+=(\"$word\")\n"
+        "        fi\n"
+        "        join=\n"
+        "        [[ \"$word\" == = ]] && join=1\n"
+        "    done\n"
+        "    local prefix=\"$", var, "_prefix\" short_prefix=\"$", var, "_short_prefix\"\n"
+        "    local cur=\"${words[${#words[@]}-1]}\" node=0 next\n"
+        "    for ((i = 0; i < ${#words[@]}-1; ++i)); do\n"
+        "        word=\"${words[i]}\"\n"
+        "        [[ \"$word\" == -- ]] && return 0\n"
+        "        [[ \"$word\" == \"$prefix\"* || ( -n \"$short_prefix\" && \"$word\" == \"$short_prefix\"* ) ]] && continue\n"
+        "        local names=\"${", var, "_command_names[node]} \" nodes=\"${", var, "_command_nodes[node]} \"\n"
+        "        next=\n"
+        "        while [[ -n \"$names\" ]]; do\n"
+        "            [[ \"${names%% *}\" == \"$word\" ]] && next=\"${nodes%% *}\" && break\n"
+        "            names=\"${names#* }\"\n"
+        "            nodes=\"${nodes#* }\"\n"
+        "        done\n"
+        "        [[ -z \"$next\" ]] && return 0\n"
+        "        node=$next\n"
+        "    done\n"
+        "    local candidates\n"
+        "    if [[ \"$cur\" == \"$prefix\"*=* ]]; then\n"
+        "        candidates=\"${", var, "_values[node]}\"\n"
+        "    elif [[ \"$cur\" == \"$prefix\"* || ( -n \"$short_prefix\" && \"$cur\" == \"$short_prefix\"* ) || ( -n \"$cur\" && \"$prefix\" == \"$cur\"* ) ]]; then\n"
+        "        candidates=\"${", var, "_options[node]}\"\n"
+        "    else\n"
+        "        candidates=\"${", var, "_command_names[node]}\"\n"
+        "    fi\n"
+        "    COMPREPLY=()\n"
+        "    ", var, "_filter \"$candidates\" \"$cur\"\n"
+        "    # Only the text after the last '=' is replaced by bash\n"
+        "    local replaced=\"${COMP_WORDS[COMP_CWORD]}\"\n"
+        "    [[ \"$replaced\" == = ]] && replaced=\n"
+        "    local strip=$(( ${#cur} - ${#replaced} ))\n"
+        "    for ((i = 0; i < ${#COMPREPLY[@]}; ++i)); do\n"
+        "        [[ \"${COMPREPLY[i]}\" == *= ]] && type compopt &>/dev/null && compopt -o nospace 2>/dev/null\n"
+        "        COMPREPLY[i]=\"${COMPREPLY[i]:strip}\"\n"
+        "    done\n"
+        "}\n\n"
+        "complete -F ", var, " "
+    );
+    AppendQuoted(script, command, false);
+    script += '\n';
+    return script;
+}
+
+namespace Argue
+{
+    constexpr bool IsTokenizerSpecial(char ch, bool isDoubleQuoted)
+    {
+        return ch == '"' || ch == '\\' || (!isDoubleQuoted && (ch == '\'' || IsSpace(ch)));
+    }
+
+    // Returns the index of the first byte at or after `pos` which ends a plain part of a word,
+    //  or the size of `text`. Within double quotes, spaces and single quotes are plain, see ::FindSpace()
+    static size_t FindTokenizerSpecial(std::string_view text, size_t pos, bool isDoubleQuoted)
+    {
+        const char* data = text.data();
+        const size_t size = text.size();
+
+        size_t i = pos;
+#ifdef ARGUE_SSE2
+        const __m128i doubleQuote = _mm_set1_epi8('"');
+        const __m128i backslash   = _mm_set1_epi8('\\');
+        const __m128i quote       = _mm_set1_epi8('\'');
+        const __m128i space       = _mm_set1_epi8(' ');
+        const __m128i rangeLo     = _mm_set1_epi8('\t' - 1);
+        const __m128i rangeHi     = _mm_set1_epi8('\r' + 1);
+        for (; i + 16 <= size; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i isSpecial = _mm_or_si128(_mm_cmpeq_epi8(block, doubleQuote), _mm_cmpeq_epi8(block, backslash));
+            if (!isDoubleQuoted) {
+                isSpecial = _mm_or_si128(isSpecial, _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, space)),
+                    _mm_and_si128(_mm_cmpgt_epi8(block, rangeLo), _mm_cmplt_epi8(block, rangeHi))));
+            }
+            if (_mm_movemask_epi8(isSpecial) != 0)
+                break;
+        }
+#else
+        for (; i + 8 <= size; i += 8) {
+            uint64_t block;
+            std::memcpy(&block, data + i, 8);
+            if (SwarHasByte(block, '"') || SwarHasByte(block, '\\'))
+                break;
+            if (!isDoubleQuoted && (SwarHasByte(block, '\'') || SwarHasLess(block, '\r' + 1) || SwarHasByte(block, ' ')))
+                break;
+        }
+#endif
+
+        // The special byte is within the current block, if any
+        for (; i < size; ++i) {
+            if (IsTokenizerSpecial(data[i], isDoubleQuoted))
+                return i;
+        }
+        return size;
+    }
+
+    // Builds a word from parts of a line, they are only copied once the word can't be a view of the line
+    class WordBuilder
+    {
+    public:
+        WordBuilder(std::string_view line, char* arena) :
+            m_Line(line),
+            m_Arena(arena)
+        {}
+
+        bool HasWord() const { return m_HasWord; }
+
+        // Appends line[start, end), an empty part still starts a word (e.g. "")
+        void Append(size_t start, size_t end)
+        {
+            if (!m_HasWord || (!m_IsInArena && m_Start == m_End)) {
+                m_HasWord = true;
+                m_Start = start;
+                m_End = end;
+                return;
+            }
+            if (start == end)
+                return;
+
+            if (!m_IsInArena) {
+                if (m_End == start) {
+                    m_End = end;
+                    return;
+                }
+                // Moved to the arena, after previous words
+                const size_t length = m_End - m_Start;
+                std::memcpy(m_Arena + m_ArenaEnd, m_Line.data() + m_Start, length);
+                m_Start = m_ArenaEnd;
+                m_End = m_ArenaEnd + length;
+                m_IsInArena = true;
+            }
+            std::memcpy(m_Arena + m_End, m_Line.data() + start, end - start);
+            m_End += end - start;
+        }
+
+        std::string_view Build()
+        {
+            std::string_view word;
+            if (m_IsInArena) {
+                word = std::string_view(m_Arena + m_Start, m_End - m_Start);
+                m_ArenaEnd = m_End;
+            } else {
+                word = m_Line.substr(m_Start, m_End - m_Start);
+            }
+            m_HasWord = false;
+            m_IsInArena = false;
+            return word;
+        }
+
+    private:
+        std::string_view m_Line;
+        char* m_Arena;
+        size_t m_ArenaEnd = 0;
+
+        bool m_HasWord = false;
+        bool m_IsInArena = false;
+        // Bounds within the line, or within the arena
+        size_t m_Start = 0;
+        size_t m_End = 0;
+    };
+}
+
+bool Argue::Tokenizer::Tokenize(std::string_view line, std::vector<std::string_view>& words)
+{
+    if (m_Arena.size() < line.size())
+        m_Arena.resize(line.size());
+
+    const size_t wordCount = words.size();
+    WordBuilder word(line, m_Arena.data());
+    bool isDoubleQuoted = false;
+    size_t i = 0;
+    while (i < line.size()) {
+        size_t end = FindTokenizerSpecial(line, i, isDoubleQuoted);
+        if (end > i) {
+            word.Append(i, end);
+            i = end;
+            continue;
+        }
+
+        const char ch = line[i];
+        if (isDoubleQuoted) {
+            const char next = i+1 < line.size() ? line[i+1] : '\0';
+            if (ch == '"') {
+                isDoubleQuoted = false;
+                ++i;
+            } else if (next == '\\' || next == '"' || next == '$' || next == '`') {
+                word.Append(i+1, i+2);
+                i += 2;
+            } else if (next == '\n') {
+                // Escaped newlines are removed
+                i += 2;
+            } else {
+                // Other backslashes are kept
+                word.Append(i, i+1);
+                ++i;
+            }
+        } else if (IsSpace(ch)) {
+            if (word.HasWord())
+                words.push_back(word.Build());
+            ++i;
+        } else if (ch == '"') {
+            isDoubleQuoted = true;
+            word.Append(i+1, i+1);
+            ++i;
+        } else if (ch == '\'') {
+            end = line.find('\'', i+1);
+            if (end == std::string_view::npos)
+                break;
+            word.Append(i+1, end);
+            i = end+1;
+        } else { // Backslash
+            if (i+1 >= line.size())
+                break;
+            // Escaped newlines are removed
+            if (line[i+1] != '\n')
+                word.Append(i+1, i+2);
+            i += 2;
+        }
+    }
+
+    if (i < line.size() || isDoubleQuoted) {
+        words.resize(wordCount);
+        return false;
+    }
+    if (word.HasWord())
+        words.push_back(word.Build());
+    return true;
+}
+
+bool Argue::IncrementalParser::Parse(const std::vector<std::string_view>& words)
+{
+    size_t sameCount = 0;
+    while (sameCount < words.size() && sameCount < m_Words.size() && words[sameCount] == m_Words[sameCount])
+        ++sameCount;
+
+    // Words which failed to parse have no checkpoint
+    m_ReusedWordCount = std::min(sameCount, m_Checkpoints.size());
+    Rollback(m_ReusedWordCount);
+
+    m_Words.resize(words.size());
+    for (size_t i = sameCount; i < words.size(); ++i)
+        m_Words[i] = words[i];
+    if (words.empty())
+        return false;
+
+    // Kept pass-through arguments were views of the previous words, each one is a whole word
+    if (std::vector<std::string_view>* passThrough = m_Parser->m_PassThrough) {
+        size_t count = 0;
+        for (size_t i = 0; i < m_ReusedWordCount; ++i) {
+            if (m_Checkpoints[i].PassThroughCount > count)
+                (*passThrough)[count++] = words[i];
+        }
+    }
+
+    std::stack<std::string_view> args;
+    for (size_t i = words.size(); i > m_ReusedWordCount; --i)
+        args.push(words[i-1]);
+    if (m_ReusedWordCount == 0)
+        return m_Parser->Parse(args);
+
+    // Commands which were being parsed are finalized once their subcommand is, see IArgParser::ParseWords()
+    ParseState state = m_Checkpoints.back().State;
+    const size_t pathLength = m_Checkpoints.back().PathLength;
+    bool hasParsed = state.Parser->ParseWords(state, args);
+    for (size_t i = pathLength-1; hasParsed && i > 0; --i)
+        hasParsed = m_Path[i-1]->Finalize();
+    return hasParsed;
+}
+
+void Argue::IncrementalParser::OnWordParsed(const ParseState& state)
+{
+    if (m_Path.empty() || m_Path.back() != state.Parser)
+        m_Path.push_back(state.Parser);
+
+    Checkpoint& checkpoint = m_Checkpoints.emplace_back();
+    checkpoint.State = state;
+    checkpoint.PathLength = m_Path.size();
+    checkpoint.ParsedValueCount = m_ParsedValues.size();
+    checkpoint.PassThroughCount = m_Parser->m_PassThrough != nullptr ? m_Parser->m_PassThrough->size() : 0;
+}
+
+void Argue::IncrementalParser::OnOptionParsed(IOption& opt, std::string_view arg, bool isShort)
+{
+    if (m_IsReplaying)
+        return;
+    m_LinkedOptions.clear();
+    opt.AppendLinkedOptions(m_LinkedOptions);
+
+    ParsedValue& value = m_ParsedValues.emplace_back();
+    value.Option = &opt;
+    value.Arg = arg;
+    value.IsShort = isShort;
+    value.HasLinkedOptions = !m_LinkedOptions.empty();
+}
+
+void Argue::IncrementalParser::OnArgumentParsed(IPositionalArgument& arg, std::string_view value)
+{
+    if (m_IsReplaying)
+        return;
+    ParsedValue& parsedValue = m_ParsedValues.emplace_back();
+    parsedValue.Argument = &arg;
+    parsedValue.Arg = value;
+}
+
+void Argue::IncrementalParser::Rollback(size_t wordCount)
+{
+    const size_t pathLength = wordCount > 0 ? m_Checkpoints[wordCount-1].PathLength : 0;
+    const size_t valueCount = wordCount > 0 ? m_Checkpoints[wordCount-1].ParsedValueCount : 0;
+
+    // Objects set by the rolled back words, mapped to the number of times the kept words parsed them
+    std::unordered_map<const void*, size_t>& parseCounts = m_ParseCounts;
+    parseCounts.clear();
+
+    std::vector<IOption*> options;
+    std::vector<IPositionalArgument*> arguments;
+    for (size_t i = valueCount; i < m_ParsedValues.size(); ++i) {
+        const ParsedValue& value = m_ParsedValues[i];
+        if (value.Option != nullptr && parseCounts.emplace(value.Option, 0).second)
+            options.push_back(value.Option);
+        if (value.Argument != nullptr && parseCounts.emplace(value.Argument, 0).second)
+            arguments.push_back(value.Argument);
+    }
+
+    // Options linked to rolled back options are also rolled back, and the other way around
+    //  (e.g. a flag which was set by its group before being set on its own)
+    const bool hasLinkedOptions = std::any_of(m_ParsedValues.begin(), m_ParsedValues.end(),
+        [](const ParsedValue& value) { return value.HasLinkedOptions; });
+    if (hasLinkedOptions && !options.empty()) {
+        std::unordered_map<const IOption*, std::vector<IOption*>> links;
+        std::vector<IOption*> linked;
+        for (const ParsedValue& value : m_ParsedValues) {
+            if (!value.HasLinkedOptions)
+                continue;
+            linked.clear();
+            value.Option->AppendLinkedOptions(linked);
+            for (IOption* opt : linked) {
+                links[value.Option].push_back(opt);
+                links[opt].push_back(value.Option);
+            }
+        }
+
+        // `options` grows while it's visited
+        for (size_t i = 0; i < options.size(); ++i) {
+            auto it = links.find(options[i]);
+            if (it == links.end())
+                continue;
+            for (IOption* opt : it->second) {
+                if (parseCounts.emplace(opt, 0).second)
+                    options.push_back(opt);
+            }
+        }
+    }
+
+    // Values are restored to what the kept words made them, those which can't be
+    //  are reset and the kept words which set them are parsed again
+    for (size_t i = 0; i < valueCount; ++i) {
+        const ParsedValue& value = m_ParsedValues[i];
+        auto it = parseCounts.find(value.Option != nullptr ? static_cast<const void*>(value.Option) : value.Argument);
+        if (it != parseCounts.end())
+            ++it->second;
+    }
+    auto restore = [&](auto& objects) {
+        for (auto* object : objects) {
+            auto it = parseCounts.find(object);
+            const size_t parseCount = it->second;
+            if (parseCount > 0 && object->RestoreValue(parseCount)) {
+                parseCounts.erase(it);
+                continue;
+            }
+            object->Reset();
+            if (parseCount == 0)
+                parseCounts.erase(it);
+        }
+    };
+    restore(options);
+    restore(arguments);
+
+    // Only the objects which were reset are left
+    m_IsReplaying = true;
+    for (size_t i = 0; i < valueCount && !parseCounts.empty(); ++i) {
+        const ParsedValue& value = m_ParsedValues[i];
+        if (value.Option != nullptr && parseCounts.contains(value.Option))
+            value.Option->Parse(value.Arg, value.IsShort);
+        else if (value.Argument != nullptr && parseCounts.contains(value.Argument))
+            value.Argument->Parse(value.Arg);
+    }
+    m_IsReplaying = false;
+
+    // Commands which are not used anymore don't keep the values of their sources
+    for (size_t i = pathLength; i < m_Path.size(); ++i) {
+        m_Path[i]->m_WasUsed = false;
+        m_Path[i]->ResetFallbacks();
+    }
+    m_Path.erase(m_Path.begin() + pathLength, m_Path.end());
+    m_Checkpoints.erase(m_Checkpoints.begin() + wordCount, m_Checkpoints.end());
+    m_ParsedValues.erase(m_ParsedValues.begin() + valueCount, m_ParsedValues.end());
+    if (m_Parser->m_PassThrough != nullptr)
+        m_Parser->m_PassThrough->resize(wordCount > 0 ? m_Checkpoints.back().PassThroughCount : 0);
+
+    m_Parser->ClearError();
+}
+
+std::vector<Argue::BatchResult> Argue::ParseBatch(
+        const std::vector<std::vector<std::string_view>>& commandLines,
+        const std::function<std::unique_ptr<IBatchWorker>()>& makeWorker,
+        size_t threadCount)
+{
+    std::vector<BatchResult> results(commandLines.size());
+    if (commandLines.empty())
+        return results;
+
+    // Consecutive lines are parsed by the same thread, their first words may be the same
+    constexpr size_t CHUNK_SIZE = 64;
+    std::atomic<size_t> nextLineIdx = 0;
+
+    // The first exception thrown by any thread, the others stop taking lines
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto stop = [&]() {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+            error = std::current_exception();
+        nextLineIdx.store(commandLines.size(), std::memory_order_relaxed);
+    };
+
+    auto parseChunks = [&]() {
+        std::unique_ptr<IBatchWorker> worker = makeWorker();
+        ArgParser& parser = worker->GetParser();
+        IncrementalParser incremental(parser);
+
+        std::vector<std::string_view> words;
+        size_t start;
+        while ((start = nextLineIdx.fetch_add(CHUNK_SIZE, std::memory_order_relaxed)) < commandLines.size()) {
+            const size_t end = std::min(start + CHUNK_SIZE, commandLines.size());
+            for (size_t i = start; i < end; ++i) {
+                words.assign(commandLines[i].begin(), commandLines[i].end());
+                if (words.empty())
+                    words.emplace_back();
+                words.front() = parser.GetName();
+
+                BatchResult& result = results[i];
+                result.IsValid = incremental.Parse(words);
+                if (!result.IsValid) {
+                    result.Error = parser.GetError();
+                    result.ErrorWordIdx = incremental.GetParsedWordCount();
+                }
+                worker->OnParsed(i, result.IsValid);
+            }
+        }
+    };
+
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = std::min(threadCount, (commandLines.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    auto tryParseChunks = [&]() {
+        try {
+            parseChunks();
+        } catch (...) {
+            stop();
+        }
+    };
+
+    // The calling thread also parses.
+    // Threads are joined on every path, an unjoined std::thread terminates the program.
+    std::vector<std::thread> threads;
+    try {
+        threads.reserve(threadCount-1);
+        for (size_t i = 1; i < threadCount; ++i)
+            threads.emplace_back(tryParseChunks);
+    } catch (...) {
+        stop();
+    }
+    tryParseChunks();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+    return results;
+}
+
+namespace Argue
+{
+    // Identifies encoded results, "ARGR" in little endian
+    constexpr uint32_t RESULT_MAGIC = 0x52475241;
+
+    struct ResultHeader
+    {
+        uint32_t Magic;
+        uint32_t Size;
+        uint32_t IsValid;
+        uint32_t ErrorOffset;
+        uint32_t ErrorLength;
+        uint32_t ValueCount;
+    };
+
+    // Presence bits are stored in 64-bit words, so that slots stay aligned
+    static size_t GetPresenceBitsSize(size_t valueCount) { return (valueCount + 63) / 64 * 8; }
+
+    static size_t CountValues(const IArgParser& parser)
+    {
+        size_t count = parser.GetOptions().size() + parser.GetArguments().size();
+        for (const IArgParser* cmd : parser.GetSubCommands())
+            count += 1 + CountValues(*cmd);
+        return count;
+    }
+
+    // Writes the values of a parser tree into an encoded result, see EncodeParseResult()
+    class ResultEncoder final :
+        public IValueWriter
+    {
+    public:
+        ResultEncoder(std::string& data, size_t valueCount) :
+            m_Data(data),
+            m_ValueCount(valueCount),
+            m_SlotsOffset(sizeof(ResultHeader) + GetPresenceBitsSize(valueCount))
+        {
+            m_Data.assign(m_SlotsOffset + valueCount * sizeof(ResultView::Slot), '\0');
+        }
+
+        // Starts the next value, it's not present unless it's written
+        void NextValue(std::string_view prefix, std::string_view name)
+        {
+            ++m_Id;
+            m_Slot = {};
+            m_Slot.KeyOffset = AppendString(prefix);
+            AppendString(name);
+            m_Slot.KeyLength = static_cast<uint32_t>(prefix.length() + name.length());
+            m_Slot.Type = ResultView::ValueType::None;
+            WriteSlot();
+        }
+
+        void WriteBool(bool value) override
+        {
+            m_Slot.Type = ResultView::ValueType::Bool;
+            m_Slot.Value = value;
+            WriteSlot();
+        }
+
+        void WriteInt(int64_t value) override
+        {
+            m_Slot.Type = ResultView::ValueType::Int;
+            m_Slot.Value = value;
+            WriteSlot();
+        }
+
+        void WriteString(std::string_view value) override
+        {
+            m_Slot.Type = ResultView::ValueType::String;
+            m_Slot.Value = AppendString(value);
+            m_Slot.Length = static_cast<uint32_t>(value.length());
+            WriteSlot();
+        }
+
+        void WriteStrings(const std::vector<std::string>& values) override { WriteStringList(values); }
+        // Same as above, values of a SchemaView are views of the parsed words
+        void WriteStrings(const std::vector<std::string_view>& values) { WriteStringList(values); }
+
+        // Returns its offset
+        uint32_t AppendString(std::string_view str)
+        {
+            const uint32_t offset = static_cast<uint32_t>(m_Data.size());
+            m_Data += str;
+            return offset;
+        }
+
+        // Appends the error and writes the header once all values were written
+        void Finish(bool isValid, std::string_view error)
+        {
+            ResultHeader header = {};
+            header.Magic = RESULT_MAGIC;
+            header.IsValid = isValid;
+            header.ValueCount = static_cast<uint32_t>(m_ValueCount);
+            header.ErrorOffset = AppendString(error);
+            header.ErrorLength = static_cast<uint32_t>(error.length());
+            header.Size = static_cast<uint32_t>(m_Data.size());
+            std::memcpy(m_Data.data(), &header, sizeof(header));
+        }
+
+    private:
+        template<typename Strings>
+        void WriteStringList(const Strings& values)
+        {
+            std::vector<uint32_t> refs;
+            refs.reserve(values.size() * 2);
+            for (std::string_view value : values) {
+                refs.push_back(AppendString(value));
+                refs.push_back(static_cast<uint32_t>(value.length()));
+            }
+
+            m_Data.resize((m_Data.size() + 3) / 4 * 4, '\0');
+            m_Slot.Type = ResultView::ValueType::Strings;
+            m_Slot.Value = AppendString(std::string_view(
+                reinterpret_cast<const char*>(refs.data()), refs.size() * sizeof(uint32_t)));
+            m_Slot.Length = static_cast<uint32_t>(values.size());
+            WriteSlot();
+        }
+
+        void WriteSlot()
+        {
+            const size_t id = m_Id - 1;
+            std::memcpy(m_Data.data() + m_SlotsOffset + id * sizeof(m_Slot), &m_Slot, sizeof(m_Slot));
+
+            char& presenceByte = m_Data[sizeof(ResultHeader) + id / 8];
+            const char presenceBit = static_cast<char>(1 << (id % 8));
+            if (m_Slot.Type == ResultView::ValueType::None)
+                presenceByte = static_cast<char>(presenceByte & ~presenceBit);
+            else
+                presenceByte = static_cast<char>(presenceByte | presenceBit);
+        }
+
+    private:
+        std::string& m_Data;
+        size_t m_ValueCount;
+        size_t m_SlotsOffset;
+        size_t m_Id = 0;
+        ResultView::Slot m_Slot = {};
+    };
+
+    // Values are numbered in the same order whether commands were used or not
+    static void EncodeValues(const IArgParser& parser, std::string_view prefix, bool isUsed, ResultEncoder& encoder)
+    {
+        for (const IOption* opt : parser.GetOptions()) {
+            encoder.NextValue(prefix, opt->GetName());
+            if (isUsed)
+                opt->WriteValue(encoder);
+        }
+
+        for (const IPositionalArgument* arg : parser.GetArguments()) {
+            encoder.NextValue(prefix, arg->GetMetaVar());
+            if (isUsed)
+                arg->WriteValue(encoder);
+        }
+
+        for (const IArgParser* cmd : parser.GetSubCommands()) {
+            const bool isCmdUsed = isUsed && *cmd;
+            encoder.NextValue(prefix, cmd->GetName());
+            if (isCmdUsed)
+                encoder.WriteBool(true);
+            EncodeValues(*cmd, s(prefix, cmd->GetName(), "/"), isCmdUsed, encoder);
+        }
+    }
+}
+
+std::string Argue::EncodeParseResult(const ArgParser& parser)
+{
+    const bool isValid = static_cast<bool>(parser);
+
+    std::string data;
+    ResultEncoder encoder(data, CountValues(parser));
+    EncodeValues(parser, "", isValid, encoder);
+    encoder.Finish(isValid, parser.GetError());
+    return data;
+}
+
+bool Argue::ResultView::Attach(std::string_view data)
+{
+    *this = ResultView();
+
+    ResultHeader header;
+    if (data.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    const uint64_t slotsOffset = sizeof(header) + GetPresenceBitsSize(header.ValueCount);
+    if (header.Magic != RESULT_MAGIC
+            || header.Size > data.size()
+            || slotsOffset + uint64_t(header.ValueCount) * sizeof(Slot) > header.Size
+            || uint64_t(header.ErrorOffset) + header.ErrorLength > header.Size) {
+        return false;
+    }
+
+    // A mapped buffer may be larger than the result
+    m_Data = data.substr(0, header.Size);
+    m_IsValid = header.IsValid != 0;
+    m_Error = m_Data.substr(header.ErrorOffset, header.ErrorLength);
+    m_ValueCount = header.ValueCount;
+    m_SlotsOffset = static_cast<size_t>(slotsOffset);
+    return true;
+}
+
+size_t Argue::ResultView::FindId(std::string_view key) const
+{
+    for (size_t id = 0; id < m_ValueCount; ++id) {
+        if (GetKey(id) == key)
+            return id;
+    }
+    return NPOS;
+}
+
+std::string_view Argue::ResultView::GetKey(size_t id) const
+{
+    Slot slot;
+    if (!ReadSlot(id, slot))
+        return std::string_view();
+    return ReadString(slot.KeyOffset, slot.KeyLength);
+}
+
+bool Argue::ResultView::HasValue(size_t id) const
+{
+    if (id >= m_ValueCount)
+        return false;
+    return (static_cast<unsigned char>(m_Data[sizeof(ResultHeader) + id / 8]) >> (id % 8)) & 1;
+}
+
+Argue::ResultView::ValueType Argue::ResultView::GetType(size_t id) const
+{
+    Slot slot;
+    if (!HasValue(id) || !ReadSlot(id, slot))
+        return ValueType::None;
+    return slot.Type;
+}
+
+bool Argue::ResultView::GetBool(size_t id, bool defaultValue) const
+{
+    Slot slot;
+    if (!HasValue(id) || !ReadSlot(id, slot) || slot.Type != ValueType::Bool)
+        return defaultValue;
+    return slot.Value != 0;
+}
+
+int64_t Argue::ResultView::GetInt(size_t id, int64_t defaultValue) const
+{
+    Slot slot;
+    if (!HasValue(id) || !ReadSlot(id, slot) || slot.Type != ValueType::Int)
+        return defaultValue;
+    return slot.Value;
+}
+
+std::string_view Argue::ResultView::GetString(size_t id, std::string_view defaultValue) const
+{
+    Slot slot;
+    if (!HasValue(id) || !ReadSlot(id, slot) || slot.Type != ValueType::String)
+        return defaultValue;
+    return ReadString(static_cast<uint64_t>(slot.Value), slot.Length);
+}
+
+size_t Argue::ResultView::GetStringCount(size_t id) const
+{
+    Slot slot;
+    if (!HasValue(id) || !ReadSlot(id, slot) || slot.Type != ValueType::Strings)
+        return 0;
+    return slot.Length;
+}
+
+std::string_view Argue::ResultView::GetStringAt(size_t id, size_t idx) const
+{
+    Slot slot;
+    if (!HasValue(id) || !ReadSlot(id, slot) || slot.Type != ValueType::Strings || idx >= slot.Length)
+        return std::string_view();
+
+    // Each string is addressed by its offset and length
+    const std::string_view ref = ReadString(static_cast<uint64_t>(slot.Value) + idx * 8, 8);
+    if (ref.empty())
+        return std::string_view();
+    uint32_t offsetAndLength[2];
+    std::memcpy(offsetAndLength, ref.data(), sizeof(offsetAndLength));
+    return ReadString(offsetAndLength[0], offsetAndLength[1]);
+}
+
+bool Argue::ResultView::ReadSlot(size_t id, Slot& slot) const
+{
+    if (id >= m_ValueCount)
+        return false;
+    std::memcpy(&slot, m_Data.data() + m_SlotsOffset + id * sizeof(Slot), sizeof(Slot));
+    return true;
+}
+
+std::string_view Argue::ResultView::ReadString(uint64_t offset, uint64_t length) const
+{
+    if (offset > m_Data.size() || length > m_Data.size() - offset)
+        return std::string_view();
+    return m_Data.substr(static_cast<size_t>(offset), static_cast<size_t>(length));
+}
+
+namespace Argue
+{
+    // The epoch of readers which don't read
+    constexpr uint64_t IDLE_EPOCH = UINT64_MAX;
+
+    // Aligned so that readers don't share cache lines, arrays of it are allocated aligned too
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<uint64_t> Epoch{IDLE_EPOCH};
+        std::atomic<bool> IsTaken{false};
+    };
+
+    // Viewed by snapshots taken before the first reload
+    const ResultView EMPTY_RESULT;
+}
+
+Argue::LiveConfig::Snapshot::Snapshot(Reader& reader) :
+    m_Reader(reader),
+    m_View(&EMPTY_RESULT)
+{
+    // Generations retired after this epoch are not freed until the reader leaves it.
+    // The epoch must be pinned before the current generation is loaded.
+    if (m_Reader.m_SnapshotCount++ == 0)
+        m_Reader.m_Slot.Epoch.store(m_Reader.m_Config.m_Epoch.load());
+
+    const Generation* gen = m_Reader.m_Config.m_Current.load();
+    if (gen != nullptr) {
+        m_View = &gen->View;
+        m_Generation = gen->Number;
+    }
+}
+
+Argue::LiveConfig::Snapshot::~Snapshot()
+{
+    if (--m_Reader.m_SnapshotCount == 0)
+        m_Reader.m_Slot.Epoch.store(IDLE_EPOCH);
+}
+
+Argue::LiveConfig::Reader::Reader(LiveConfig& config, ReaderSlot& slot) :
+    m_Config(config),
+    m_Slot(slot)
+{}
+
+Argue::LiveConfig::Reader::~Reader()
+{
+    m_Slot.IsTaken.store(false);
+}
+
+Argue::LiveConfig::LiveConfig(ArgParser& parser, size_t maxReaderCount) :
+    m_Slots(new ReaderSlot[maxReaderCount]),
+    m_SlotCount(maxReaderCount),
+    m_Incremental(parser)
+{}
+
+Argue::LiveConfig::~LiveConfig()
+{
+    delete m_Current.load();
+}
+
+std::unique_ptr<Argue::LiveConfig::Reader> Argue::LiveConfig::AddReader()
+{
+    for (size_t i = 0; i < m_SlotCount; ++i) {
+        bool isTaken = false;
+        if (m_Slots[i].IsTaken.compare_exchange_strong(isTaken, true))
+            return std::unique_ptr<Reader>(new Reader(*this, m_Slots[i]));
+    }
+    return nullptr;
+}
+
+bool Argue::LiveConfig::Reload(const std::vector<std::string_view>& args)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_Words.clear();
+    m_Words.push_back(m_Incremental.GetParser().GetName());
+    m_Words.insert(m_Words.end(), args.begin(), args.end());
+    if (!m_Incremental.Parse(m_Words))
+        return false;
+
+    // The view must not be attached before the data is in its final place
+    std::unique_ptr<Generation> gen(new Generation());
+    gen->Data = EncodeParseResult(m_Incremental.GetParser());
+    gen->View.Attach(gen->Data);
+    gen->Number = ++m_GenerationCount;
+
+    // Readers which pin the new epoch can only load the new generation
+    Generation* replaced = m_Current.exchange(gen.release());
+    const uint64_t epoch = m_Epoch.fetch_add(1) + 1;
+    if (replaced != nullptr)
+        m_Retired.push_back({std::unique_ptr<Generation>(replaced), epoch});
+
+    Collect();
+    return true;
+}
+
+std::string Argue::LiveConfig::GetError() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Incremental.GetParser().GetError();
+}
+
+size_t Argue::LiveConfig::GetRetiredCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Retired.size();
+}
+
+void Argue::LiveConfig::Collect()
+{
+    uint64_t oldestEpoch = IDLE_EPOCH;
+    for (size_t i = 0; i < m_SlotCount; ++i)
+        oldestEpoch = std::min(oldestEpoch, m_Slots[i].Epoch.load());
+
+    m_Retired.erase(
+        std::remove_if(
+            m_Retired.begin(), m_Retired.end(),
+            [oldestEpoch](const RetiredGeneration& retired) { return retired.Epoch <= oldestEpoch; }),
+        m_Retired.end());
+}
+
+#ifdef ARGUE_POSIX
+namespace Argue
+{
+    // Requests larger than this are not answered, so that clients can't exhaust the server's memory
+    constexpr size_t MAX_REQUEST_SIZE = 1 << 20;
+    // Answers larger than this are not read, so that a rogue server can't exhaust the client's memory
+    constexpr size_t MAX_ANSWER_SIZE = 1 << 26;
+    // Further connections wait to be accepted until others are closed
+    constexpr size_t MAX_CONNECTIONS = 256;
+    // Connections idle for longer are closed, so that stalled clients don't hold on to the server
+    constexpr int64_t CONNECTION_TIMEOUT_MS = 10000;
+    // How often idle connections are looked for, and ::Stop() noticed if it could not wake up poll()
+    constexpr int POLL_INTERVAL_MS = 1000;
+    // RequestParse() gives up if the server stalls for longer, the program then parses on its own
+    constexpr int REQUEST_TIMEOUT_MS = 5000;
+
+#ifdef MSG_NOSIGNAL
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    constexpr int SEND_FLAGS = 0; // SO_NOSIGPIPE is set instead, see ::IgnoreSigPipe()
+#endif
+
+    // Writes to a closed socket must not kill the process
+    static void IgnoreSigPipe(int fd)
+    {
+#ifdef SO_NOSIGPIPE
+        int isSet = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &isSet, sizeof(isSet));
+#else
+        ARGUE_UNUSED(fd);
+#endif
+    }
+
+    static bool SendAll(int fd, const void* data, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t sent = send(fd, bytes, size, SEND_FLAGS);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            bytes += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    // Returns false on errors and if the connection is closed before `size` bytes are read
+    static bool ReceiveAll(int fd, void* data, size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0) {
+            ssize_t received = recv(fd, bytes, size, 0);
+            if (received < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (received == 0)
+                return false;
+            bytes += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    // Appends the length of `message` followed by it
+    static void AppendMessage(std::string& output, std::string_view message)
+    {
+        const uint32_t length = static_cast<uint32_t>(message.length());
+        output.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        output += message;
+    }
+
+    static bool ReceiveMessage(int fd, std::string& message, size_t maxLength)
+    {
+        uint32_t length;
+        if (!ReceiveAll(fd, &length, sizeof(length)) || length > maxLength)
+            return false;
+        message.resize(length);
+        return ReceiveAll(fd, message.data(), length);
+    }
+
+    static bool SetNonBlocking(int fd)
+    {
+        const int flags = fcntl(fd, F_GETFL);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    // Sends and receives on `fd` fail with EAGAIN once they block for `milliseconds`
+    static void SetTimeout(int fd, int milliseconds)
+    {
+        timeval timeout = {};
+        timeout.tv_sec = milliseconds / 1000;
+        timeout.tv_usec = (milliseconds % 1000) * 1000;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    }
+
+    static int64_t GetMilliseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Returns false if `path` does not fit within `address`
+    static bool MakeSocketAddress(std::string_view path, sockaddr_un& address)
+    {
+        address = {};
+        address.sun_family = AF_UNIX;
+        if (path.length() >= sizeof(address.sun_path))
+            return false;
+        std::memcpy(address.sun_path, path.data(), path.length());
+        return true;
+    }
+}
+
+Argue::ParseServer::ParseServer(ArgParser& parser, size_t cacheCapacity) :
+    m_Incremental(parser),
+    m_Fingerprint(FingerprintSchema(EncodeSchema(parser))),
+    m_CacheCapacity(cacheCapacity)
+{}
+
+Argue::ParseServer::~ParseServer()
+{
+    for (const Connection& connection : m_Connections)
+        close(connection.Fd);
+    if (m_Fd >= 0) {
+        close(m_Fd);
+        unlink(m_SocketPath.c_str());
+    }
+}
+
+bool Argue::ParseServer::Listen(std::string_view socketPath)
+{
+    sockaddr_un address;
+    if (!MakeSocketAddress(socketPath, address)) {
+        errno = ENAMETOOLONG;
+        return SetError(s("Could not listen on '", socketPath, "'"));
+    }
+
+    // A previous server may have left its socket behind, other files are never removed
+    struct stat info;
+    if (lstat(address.sun_path, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            errno = EEXIST;
+            return SetError(s("Could not listen on '", socketPath, "'"));
+        }
+
+        const int probeFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probeFd < 0)
+            return SetError("Could not create socket");
+        const bool isServed = connect(probeFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        close(probeFd);
+        if (isServed) {
+            errno = EADDRINUSE;
+            return SetError(s("Could not listen on '", socketPath, "'"));
+        }
+        unlink(address.sun_path);
+    }
+
+    m_Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_Fd < 0)
+        return SetError("Could not create socket");
+
+    if (bind(m_Fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(m_Fd, SOMAXCONN) != 0) {
+        SetError(s("Could not listen on '", socketPath, "'"));
+        close(m_Fd);
+        m_Fd = -1;
+        return false;
+    }
+
+    m_SocketPath = socketPath;
+    return true;
+}
+
+bool Argue::ParseServer::Serve()
+{
+    if (m_Fd < 0) {
+        m_Error = "The server is not listening.";
+        return false;
+    }
+    if (!SetNonBlocking(m_Fd))
+        return SetError("Could not configure socket");
+
+    // The socket is polled first, followed by each connection
+    std::vector<pollfd> polled;
+    while (!m_IsStopped) {
+        polled.clear();
+        polled.push_back({ m_Fd, static_cast<short>(m_Connections.size() < MAX_CONNECTIONS ? POLLIN : 0), 0 });
+        for (const Connection& connection : m_Connections) {
+            // Requests are not read while answers are waiting to be sent,
+            // so that answers can't pile up for a client which does not read them
+            polled.push_back({ connection.Fd, static_cast<short>(connection.Output.empty() ? POLLIN : POLLOUT), 0 });
+        }
+
+        if (poll(polled.data(), static_cast<nfds_t>(polled.size()), POLL_INTERVAL_MS) < 0) {
+            if (errno == EINTR)
+                continue;
+            return SetError("Could not wait for requests");
+        }
+        if (m_IsStopped)
+            break;
+
+        const int64_t now = GetMilliseconds();
+        for (size_t i = 0; i < m_Connections.size(); ++i) {
+            Connection& connection = m_Connections[i];
+            const short events = polled[i+1].revents;
+
+            bool isOpen = true;
+            if (events & (POLLERR | POLLNVAL))
+                isOpen = false;
+            else if (events & POLLOUT)
+                isOpen = Send(connection);
+            else if (events & (POLLIN | POLLHUP))
+                isOpen = Receive(connection);
+
+            if (events != 0)
+                connection.Deadline = now + CONNECTION_TIMEOUT_MS;
+            else if (now >= connection.Deadline)
+                isOpen = false;
+
+            if (!isOpen) {
+                close(connection.Fd);
+                connection.Fd = -1;
+            }
+        }
+        m_Connections.erase(
+            std::remove_if(
+                m_Connections.begin(), m_Connections.end(),
+                [](const Connection& connection) { return connection.Fd < 0; }),
+            m_Connections.end());
+
+        if (polled.front().revents != 0 && !Accept(now))
+            return false;
+    }
+
+    for (const Connection& connection : m_Connections)
+        close(connection.Fd);
+    m_Connections.clear();
+    return true;
+}
+
+void Argue::ParseServer::Stop()
+{
+    m_IsStopped = true;
+    // Wakes up ::Serve() if it's waiting for requests
+    if (m_Fd >= 0)
+        shutdown(m_Fd, SHUT_RDWR);
+}
+
+bool Argue::ParseServer::Accept(int64_t now)
+{
+    while (m_Connections.size() < MAX_CONNECTIONS) {
+        int fd = accept(m_Fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK || m_IsStopped)
+                return true;
+            return SetError("Could not accept connection");
+        }
+
+        if (!SetNonBlocking(fd)) {
+            close(fd);
+            continue;
+        }
+        IgnoreSigPipe(fd);
+        m_Connections.push_back({ fd, {}, {}, now + CONNECTION_TIMEOUT_MS });
+    }
+    return true;
+}
+
+bool Argue::ParseServer::Receive(Connection& connection)
+{
+    char buffer[1 << 14];
+    const ssize_t received = recv(connection.Fd, buffer, sizeof(buffer), 0);
+    if (received < 0)
+        return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+    if (received == 0)
+        return false; // The client closed the connection
+    connection.Input.append(buffer, static_cast<size_t>(received));
+
+    // Clients may send multiple requests, until they close the connection
+    const std::string_view input = connection.Input;
+    size_t offset = 0;
+    uint32_t length;
+    while (input.length() - offset >= sizeof(length)) {
+        std::memcpy(&length, input.data() + offset, sizeof(length));
+        if (length > MAX_REQUEST_SIZE)
+            return false;
+        if (input.length() - offset - sizeof(length) < length)
+            break;
+        AppendMessage(connection.Output, Answer(input.substr(offset + sizeof(length), length)));
+        offset += sizeof(length) + length;
+    }
+    connection.Input.erase(0, offset);
+    return true;
+}
+
+bool Argue::ParseServer::Send(Connection& connection)
+{
+    const ssize_t sent = send(connection.Fd, connection.Output.data(), connection.Output.size(), SEND_FLAGS);
+    if (sent < 0)
+        return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+    connection.Output.erase(0, static_cast<size_t>(sent));
+    return true;
+}
+
+std::string_view Argue::ParseServer::Answer(std::string_view request)
+{
+    uint64_t fingerprint;
+    if (request.size() < sizeof(fingerprint))
+        return {};
+    std::memcpy(&fingerprint, request.data(), sizeof(fingerprint));
+    if (fingerprint != m_Fingerprint)
+        return {};
+    request.remove_prefix(sizeof(fingerprint));
+
+    // The program's name is not part of the key, it may be any path to the program
+    const size_t nameEnd = request.find('\0');
+    const std::string_view key = nameEnd == std::string_view::npos
+        ? std::string_view()
+        : request.substr(nameEnd+1);
+
+    auto cached = m_CacheIndex.find(key);
+    if (cached != m_CacheIndex.end()) {
+        m_Cache.splice(m_Cache.begin(), m_Cache, cached->second);
+        return cached->second->second;
+    }
+
+    m_Words.clear();
+    m_Words.push_back(m_Incremental.GetParser().GetName());
+    for (std::string_view words = key; !words.empty(); ) {
+        const size_t wordEnd = words.find('\0');
+        m_Words.push_back(words.substr(0, wordEnd));
+        words.remove_prefix(wordEnd == std::string_view::npos ? words.size() : wordEnd+1);
+    }
+    m_Incremental.Parse(m_Words);
+
+    if (m_CacheCapacity == 0) {
+        m_Answer = EncodeParseResult(m_Incremental.GetParser());
+        return m_Answer;
+    }
+
+    if (m_Cache.size() >= m_CacheCapacity) {
+        m_CacheIndex.erase(m_Cache.back().first);
+        m_Cache.pop_back();
+    }
+    m_Cache.emplace_front(key, EncodeParseResult(m_Incremental.GetParser()));
+    m_CacheIndex.emplace(m_Cache.front().first, m_Cache.begin());
+    return m_Cache.front().second;
+}
+
+bool Argue::ParseServer::SetError(std::string_view message)
+{
+    m_Error = s(message, ": ", std::strerror(errno), ".");
+    return false;
+}
+
+Argue::SharedResult::~SharedResult()
+{
+    Unmap();
+}
+
+bool Argue::SharedResult::Publish(std::string_view encoded)
+{
+    Unmap();
+
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    m_Fd = memfd_create("argue-result", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (m_Fd < 0)
+        return SetError("Could not create memory file");
+
+    for (std::string_view remaining = encoded; !remaining.empty(); ) {
+        ssize_t written = write(m_Fd, remaining.data(), remaining.size());
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            SetError("Could not write memory file");
+            Unmap();
+            return false;
+        }
+        remaining.remove_prefix(static_cast<size_t>(written));
+    }
+
+    // Sealed, so that readers can trust that the result never changes
+    if (fcntl(m_Fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+        SetError("Could not seal memory file");
+        Unmap();
+        return false;
+    }
+#else
+    // The name is only needed to open it, the object lives on through its descriptor
+    static std::atomic<uint32_t> objectCount = 0;
+    const std::string name = s("/argue-", std::to_string(getpid()), "-", std::to_string(objectCount++));
+    m_Fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (m_Fd < 0)
+        return SetError("Could not create shared memory");
+    shm_unlink(name.c_str());
+    fcntl(m_Fd, F_SETFD, FD_CLOEXEC);
+
+    // Shared memory objects can't always be written to, only mapped
+    void* data = MAP_FAILED;
+    if (ftruncate(m_Fd, static_cast<off_t>(encoded.size())) == 0)
+        data = mmap(nullptr, encoded.size(), PROT_READ | PROT_WRITE, MAP_SHARED, m_Fd, 0);
+    if (data == MAP_FAILED) {
+        SetError("Could not write shared memory");
+        Unmap();
+        return false;
+    }
+    std::memcpy(data, encoded.data(), encoded.size());
+    munmap(data, encoded.size());
+#endif
+
+    m_Data = mmap(nullptr, encoded.size(), PROT_READ, MAP_SHARED, m_Fd, 0);
+    if (m_Data == MAP_FAILED) {
+        m_Data = nullptr;
+        SetError("Could not map shared result");
+        Unmap();
+        return false;
+    }
+    m_Size = encoded.size();
+
+    if (!m_View.Attach(std::string_view(static_cast<const char*>(m_Data), m_Size))) {
+        m_Error = "The shared result is not an encoded result.";
+        Unmap();
+        return false;
+    }
+    return true;
+}
+
+bool Argue::SharedResult::Map(int fd)
+{
+    Unmap();
+
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+        return SetError("Could not map shared result");
+    const size_t size = static_cast<size_t>(status.st_size);
+
+    m_Data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (m_Data == MAP_FAILED) {
+        m_Data = nullptr;
+        return SetError("Could not map shared result");
+    }
+    m_Size = size;
+
+    if (!m_View.Attach(std::string_view(static_cast<const char*>(m_Data), m_Size))) {
+        m_Error = "The shared result is not an encoded result.";
+        Unmap();
+        return false;
+    }
+    return true;
+}
+
+void Argue::SharedResult::Unmap()
+{
+    m_View = ResultView();
+    if (m_Data != nullptr)
+        munmap(m_Data, m_Size);
+    m_Data = nullptr;
+    m_Size = 0;
+    if (m_Fd >= 0)
+        close(m_Fd);
+    m_Fd = -1;
+}
+
+bool Argue::SharedResult::SetError(std::string_view message)
+{
+    m_Error = s(message, ": ", std::strerror(errno), ".");
+    return false;
+}
+
+bool Argue::RequestParse(std::string_view socketPath, uint64_t fingerprint, int argc, const char** argv, ParseResult& result)
+{
+    sockaddr_un address;
+    if (!MakeSocketAddress(socketPath, address))
+        return false;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return false;
+    IgnoreSigPipe(fd);
+    SetTimeout(fd, REQUEST_TIMEOUT_MS);
+
+    std::string message(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+    for (int i = 0; i < argc; ++i) {
+        message += argv[i];
+        message += '\0';
+    }
+    std::string request;
+    AppendMessage(request, message);
+
+    bool isAnswered = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+        && SendAll(fd, request.data(), request.length())
+        && ReceiveMessage(fd, message, MAX_ANSWER_SIZE);
+    close(fd);
+    return isAnswered && !message.empty() && result.Assign(std::move(message));
+}
+#endif // ARGUE_POSIX
+
+namespace Argue
+{
+    // Identifies schema images, "ARGS" in little endian
+    constexpr uint32_t SCHEMA_MAGIC = 0x53475241;
+    // Deeper commands are not accepted, so that checking and parsing an image can't exhaust the stack
+    constexpr size_t MAX_SCHEMA_DEPTH = 256;
+
+    // Records the calls made to it, see SchemaView::TextRecord
+    class TextRecorder final :
+        public ITextBuilder
+    {
+    public:
+        using Call = SchemaView::TextRecord::Call;
+
+        void PutText(std::string_view text) override { m_Calls.emplace_back(Call::PutText, text); }
+
+        void NewLine() override { m_Calls.emplace_back(Call::NewLine, ""); }
+        void Spacer() override { m_Calls.emplace_back(Call::Spacer, ""); }
+
+        void Indent() override { m_Calls.emplace_back(Call::Indent, ""); }
+        void DeIndent() override { m_Calls.emplace_back(Call::DeIndent, ""); }
+
+        // Nothing is built, see ::GetCalls()
+        std::string Build() override { return ""; }
+
+        const std::vector<std::pair<Call, std::string>>& GetCalls() const { return m_Calls; }
+
+    private:
+        std::vector<std::pair<Call, std::string>> m_Calls;
+    };
+
+    // Builds a schema image, see EncodeSchema()
+    class SchemaEncoder
+    {
+    public:
+        using Span = SchemaView::Span;
+        using ValueRecord = SchemaView::ValueRecord;
+        using CommandRecord = SchemaView::CommandRecord;
+        using NameRecord = SchemaView::NameRecord;
+        using TextRecord = SchemaView::TextRecord;
+
+        // Returns an empty string if the tree can't be encoded
+        std::string Encode(const ArgParser& parser)
+        {
+            if (!Collect(parser, "", SchemaView::NONE, 0))
+                return "";
+
+            SchemaView::Header header = {};
+            header.Magic = SCHEMA_MAGIC;
+            header.Version = SchemaView::VERSION;
+            header.ValueCount = static_cast<uint32_t>(m_Values.size());
+            header.CommandCount = static_cast<uint32_t>(m_Commands.size());
+
+            const size_t valuesOffset = sizeof(header);
+            const size_t commandsOffset = valuesOffset + m_Values.size() * sizeof(ValueRecord);
+            m_Data.assign(commandsOffset + m_Commands.size() * sizeof(CommandRecord), '\0');
+            header.Prefix = AppendString(parser.GetPrefix());
+            header.ShortPrefix = AppendString(parser.GetShortPrefix());
+
+            for (size_t id = 0; id < m_Values.size(); ++id) {
+                ValueRecord record = {};
+                if (!EncodeValue(m_Values[id], record))
+                    return "";
+                std::memcpy(m_Data.data() + valuesOffset + id * sizeof(record), &record, sizeof(record));
+            }
+
+            for (size_t idx = 0; idx < m_Commands.size(); ++idx) {
+                CommandRecord record = {};
+                EncodeCommand(m_Commands[idx], record);
+                std::memcpy(m_Data.data() + commandsOffset + idx * sizeof(record), &record, sizeof(record));
+            }
+
+            if (m_Data.size() > UINT32_MAX)
+                return "";
+            header.Size = static_cast<uint32_t>(m_Data.size());
+            std::memcpy(m_Data.data(), &header, sizeof(header));
+            return std::move(m_Data);
+        }
+
+    private:
+        struct Value
+        {
+            const IOption* Option = nullptr;
+            const IPositionalArgument* Argument = nullptr;
+            uint32_t Command = SchemaView::NONE;
+            std::string Key;
+            size_t NameLength = 0; // The name ends the key
+        };
+
+        struct Command
+        {
+            const IArgParser* Parser;
+            uint32_t Id;
+            uint32_t FirstOption;
+            std::vector<uint32_t> SubCommands;
+        };
+
+        // Numbers commands depth first and values in the same order as EncodeValues() does
+        bool Collect(const IArgParser& parser, std::string_view prefix, uint32_t id, size_t depth)
+        {
+            // Commands are only matched by their names within images
+            if (depth > MAX_SCHEMA_DEPTH || parser.ParsesCustomWords())
+                return false;
+
+            const size_t idx = m_Commands.size();
+            m_Commands.push_back({ &parser, id, static_cast<uint32_t>(m_Values.size()), {} });
+
+            for (const IOption* opt : parser.GetOptions())
+                m_Values.push_back({ opt, nullptr, SchemaView::NONE, s(prefix, opt->GetName()), opt->GetName().size() });
+            for (const IPositionalArgument* arg : parser.GetArguments())
+                m_Values.push_back({ nullptr, arg, SchemaView::NONE, s(prefix, arg->GetMetaVar()), arg->GetMetaVar().size() });
+
+            for (const IArgParser* cmd : parser.GetSubCommands()) {
+                const uint32_t cmdIdx = static_cast<uint32_t>(m_Commands.size());
+                const uint32_t cmdId = static_cast<uint32_t>(m_Values.size());
+                m_Values.push_back({ nullptr, nullptr, cmdIdx, s(prefix, cmd->GetName()), cmd->GetName().size() });
+                m_Commands[idx].SubCommands.push_back(cmdIdx);
+                if (!Collect(*cmd, s(prefix, cmd->GetName(), "/"), cmdId, depth+1))
+                    return false;
+            }
+            return true;
+        }
+
+        bool EncodeValue(const Value& value, ValueRecord& record)
+        {
+            record.Command = value.Command;
+            record.Key = AppendString(value.Key);
+            record.Name = { record.Key.Offset + static_cast<uint32_t>(value.Key.size() - value.NameLength),
+                            static_cast<uint32_t>(value.NameLength) };
+
+            SchemaEntry entry;
+            if (value.Argument != nullptr) {
+                if (!value.Argument->WriteSchema(entry) || entry.Type < SchemaEntry::Kind::Argument)
+                    return false;
+                record.MetaVar = record.Name;
+                record.Description = AppendString(value.Argument->GetDescription());
+                record.HasDefault = value.Argument->HasDefaultValue();
+                record.Hint = RecordText([&](ITextBuilder& hint) { value.Argument->WriteHint(hint); });
+                record.Help = RecordText([&](ITextBuilder& help) { value.Argument->WriteHelp(help); });
+            } else if (value.Option != nullptr) {
+                const IOption& opt = *value.Option;
+                if (!opt.WriteSchema(entry) || entry.Type > SchemaEntry::Kind::Collection)
+                    return false;
+                record.ShortName = AppendString(opt.GetShortName());
+                record.MetaVar = AppendString(opt.GetMetaVar());
+                record.Description = AppendString(opt.GetDescription());
+                record.HasDefault = opt.HasDefaultValue();
+                record.IsVarOptional = opt.IsVarOptional();
+                record.Aliases = AppendStrings(opt.GetAliases());
+                if (entry.Choices != nullptr)
+                    record.Choices = AppendStrings(*entry.Choices);
+                record.Hint = RecordText([&](ITextBuilder& hint) { opt.WriteHint(hint); });
+                record.Help = RecordText([&](ITextBuilder& help) { opt.WriteHelp(help); });
+                std::vector<std::string> completions;
+                opt.CompleteValue("", completions);
+                std::sort(completions.begin(), completions.end());
+                record.Completions = AppendStrings(completions);
+
+                std::vector<IOption*> linked;
+                opt.AppendLinkedOptions(linked);
+                std::vector<uint32_t> linkedIds;
+                for (const IOption* linkedOpt : linked) {
+                    const uint32_t linkedId = FindOption(linkedOpt);
+                    if (entry.Type != SchemaEntry::Kind::Flag || linkedId == SchemaView::NONE)
+                        return false;
+                    linkedIds.push_back(linkedId);
+                }
+                record.Linked = AppendList(linkedIds);
+            }
+
+            record.Type = entry.Type;
+            record.DefaultString = AppendString(entry.DefaultString);
+            record.DefaultInt = entry.DefaultInt;
+            return true;
+        }
+
+        void EncodeCommand(const Command& cmd, CommandRecord& record)
+        {
+            const IArgParser& parser = *cmd.Parser;
+            record.Id = cmd.Id;
+            record.Name = AppendString(parser.GetName());
+            record.Description = AppendString(parser.GetDescription());
+            record.FirstOption = cmd.FirstOption;
+            record.OptionCount = static_cast<uint32_t>(parser.GetOptions().size());
+            record.FirstArgument = record.FirstOption + record.OptionCount;
+            record.ArgumentCount = static_cast<uint32_t>(parser.GetArguments().size());
+            record.SubCommands = AppendList(cmd.SubCommands);
+            record.OptionNames = AppendNames(parser.GetOptionNames());
+            record.CommandNames = AppendNames(parser.GetCommandNames());
+            record.ShortNames = AppendNames(parser.GetShortOptionNames());
+            std::vector<uint32_t> customOptions;
+            for (size_t idx : parser.GetCustomOptions())
+                customOptions.push_back(static_cast<uint32_t>(idx));
+            record.CustomOptions = AppendList(customOptions);
+            record.Hint = RecordText([&](ITextBuilder& hint) { parser.WriteHint(hint); });
         }
-    }
+
+        uint32_t FindOption(const IOption* opt) const
+        {
+            for (size_t id = 0; id < m_Values.size(); ++id) {
+                if (m_Values[id].Option == opt)
+                    return static_cast<uint32_t>(id);
+            }
+            return SchemaView::NONE;
+        }
+
+        Span AppendString(std::string_view str)
+        {
+            const Span span = { static_cast<uint32_t>(m_Data.size()), static_cast<uint32_t>(str.length()) };
+            m_Data += str;
+            return span;
+        }
+
+        // Lists are aligned to 4 bytes
+        template<typename Record>
+        Span AppendList(const std::vector<Record>& records)
+        {
+            m_Data.resize((m_Data.size() + 3) / 4 * 4, '\0');
+            const Span span = { static_cast<uint32_t>(m_Data.size()), static_cast<uint32_t>(records.size()) };
+            m_Data.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+            return span;
+        }
+
+        Span AppendStrings(const std::vector<std::string>& strings)
+        {
+            std::vector<Span> spans;
+            for (const std::string& str : strings)
+                spans.push_back(AppendString(str));
+            return AppendList(spans);
+        }
+
+        template<typename Write>
+        Span RecordText(const Write& write)
+        {
+            TextRecorder recorder;
+            write(recorder);
+
+            std::vector<TextRecord> records;
+            for (const auto& [method, text] : recorder.GetCalls())
+                records.push_back({ method, AppendString(text) });
+            return AppendList(records);
+        }
+
+        // Names are listed in the order of the trie, which is the order of a binary search
+        Span AppendNames(const NameTrie& names)
+        {
+            std::vector<NameTrie::Match> matches;
+            names.FindWithPrefix("", matches);
+
+            std::vector<NameRecord> records;
+            for (const NameTrie::Match& match : matches)
+                records.push_back({ AppendString(match.Name), static_cast<uint32_t>(match.Index) });
+            return AppendList(records);
+        }
+
+    private:
+        std::vector<Command> m_Commands;
+        std::vector<Value> m_Values;
+        std::string m_Data;
+    };
+
+    // The values of a command line parsed with a schema image, see ImageCommand
+    class SchemaParser
+    {
+    public:
+        using Span = SchemaView::Span;
+        using ValueRecord = SchemaView::ValueRecord;
+        using CommandRecord = SchemaView::CommandRecord;
+
+        SchemaParser(const SchemaView& schema, std::vector<std::string_view>* passThrough) :
+            m_Schema(schema),
+            m_PassThrough(passThrough),
+            m_Values(schema.m_ValueCount),
+            m_IsCommandUsed(schema.m_CommandCount, false)
+        {}
+
+        // Same as EncodeParseResult() of the encoded tree
+        std::string Encode()
+        {
+            // Values of each collection are kept in the order they were parsed
+            std::stable_sort(m_Items.begin(), m_Items.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+
+            const bool isValid = m_IsCommandUsed[0] && !HasError();
+            std::string data;
+            ResultEncoder encoder(data, m_Schema.m_ValueCount);
+            EncodeValues(m_Schema.ReadCommand(0), isValid, encoder);
+            encoder.Finish(isValid, m_Error);
+            return data;
+        }
+
+        void SetUsed(size_t cmdIdx) { m_IsCommandUsed[cmdIdx] = true; }
+        bool WasParsed(size_t id) const { return m_Values[id].WasParsed; }
+
+        // Same as IOption::Parse() of the built-in option types
+        bool ParseOption(size_t id, std::string_view arg, bool isShort)
+        {
+            const ValueRecord opt = m_Schema.ReadValue(id);
+            ValueState& value = m_Values[id];
+            const auto getAlias = [&](size_t i) { return m_Schema.ReadString(m_Schema.ReadAt<Span>(opt.Aliases, i)); };
+
+            const std::string_view name = m_Schema.ReadString(opt.Name);
+            const bool hasConsumedName = ConsumeOptionName(arg, isShort, name, m_Schema.ReadString(opt.ShortName), opt.Aliases.Length, getAlias);
+            if (opt.Type == SchemaEntry::Kind::Flag) {
+                const auto isLongName = [&](std::string_view longName) { return IsOptionName(longName, name, opt.Aliases.Length, getAlias); };
+                bool flag = false;
+                if (!ParseFlagArg(arg, isShort, hasConsumedName, isLongName, flag))
+                    return false;
+                SetFlag(id, flag);
+                value.WasParsed = true;
+                return true;
+            }
+
+            if (!hasConsumedName || !ConsumeValueSeparator(arg, isShort, opt.MetaVar.Length > 0))
+                return false;
+
+            std::string error;
+            switch (opt.Type) {
+            case SchemaEntry::Kind::Int:
+                if (!ParseIntValue(arg, m_Schema.m_Prefix, name, value.Int, error))
+                    return SetError(std::move(error));
+                break;
+            case SchemaEntry::Kind::Choice: {
+                const auto getChoice = [&](size_t i) { return m_Schema.ReadString(m_Schema.ReadAt<Span>(opt.Choices, i)); };
+                size_t choiceIdx = 0;
+                if (!ParseChoiceValue(arg, opt.Choices.Length, getChoice, m_Schema.m_Prefix, name, choiceIdx, error))
+                    return SetError(std::move(error));
+                value.Int = static_cast<int64_t>(choiceIdx);
+                break;
+            }
+            case SchemaEntry::Kind::Collection:
+                // Collections accept empty values if their value is optional, see CollectionOption::IsVarOptional()
+                if (!CheckCollectionValue(arg, opt.IsVarOptional, m_Schema.m_Prefix, name, error))
+                    return SetError(std::move(error));
+                m_Items.emplace_back(static_cast<uint32_t>(id), arg);
+                break;
+            default:
+                value.String = arg;
+                break;
+            }
+
+            value.WasParsed = true;
+            return true;
+        }
+
+        // Same as IPositionalArgument::Parse() of the built-in argument types
+        bool ParseArgument(size_t id, std::string_view arg)
+        {
+            if (m_Schema.ReadValue(id).Type == SchemaEntry::Kind::VarArgument) {
+                m_Items.emplace_back(static_cast<uint32_t>(id), arg);
+            } else {
+                m_Values[id].String = arg;
+            }
+            m_Values[id].WasParsed = true;
+            return true;
+        }
+
+        bool HasError() const { return !m_Error.empty(); }
+        // Always returns false, like IArgParser::SetError()
+        bool SetError(std::string&& errorMessage)
+        {
+            m_Error = std::move(errorMessage);
+            return false;
+        }
+
+        // Same as ArgParser::PassThrough()
+        bool PassThrough(std::string_view arg)
+        {
+            if (m_PassThrough == nullptr)
+                return false;
+            m_PassThrough->push_back(arg);
+            return true;
+        }
+
+        // Values are views of the words, words which are not part of the command line are kept until it's encoded
+        std::string_view KeepWord(std::string&& word)
+        {
+            m_KeptWords.push_back(std::make_unique<std::string>(std::move(word)));
+            return *m_KeptWords.back();
+        }
+
+    private:
+        struct ValueState
+        {
+            bool WasParsed = false;
+            bool IsFlagSet = false; // Flags are set by linked flags even if they were not parsed
+            bool Flag = false;
+            int64_t Int = 0; // Also the index of a choice
+            std::string_view String;
+        };
+
+        // Same as FlagGroupOption::SetValue(), flags of nested groups are linked too
+        void SetFlag(size_t id, bool flag)
+        {
+            m_Values[id].IsFlagSet = true;
+            m_Values[id].Flag = flag;
+
+            const Span linked = m_Schema.ReadValue(id).Linked;
+            for (size_t i = 0; i < linked.Length; ++i) {
+                ValueState& value = m_Values[m_Schema.ReadAt<uint32_t>(linked, i)];
+                value.IsFlagSet = true;
+                value.Flag = flag;
+            }
+        }
+
+        // Same as EncodeValues()
+        void EncodeValues(const CommandRecord& cmd, bool isUsed, ResultEncoder& encoder) const
+        {
+            for (size_t id = cmd.FirstOption; id < cmd.FirstArgument + cmd.ArgumentCount; ++id) {
+                const ValueRecord value = m_Schema.ReadValue(id);
+                encoder.NextValue("", m_Schema.ReadString(value.Key));
+                if (isUsed)
+                    WriteValue(id, value, encoder);
+            }
+
+            for (size_t i = 0; i < cmd.SubCommands.Length; ++i) {
+                const uint32_t subIdx = m_Schema.ReadAt<uint32_t>(cmd.SubCommands, i);
+                const CommandRecord sub = m_Schema.ReadCommand(subIdx);
+                const bool isSubUsed = isUsed && m_IsCommandUsed[subIdx];
+                encoder.NextValue("", m_Schema.ReadString(m_Schema.ReadValue(sub.Id).Key));
+                if (isSubUsed)
+                    encoder.WriteBool(true);
+                EncodeValues(sub, isSubUsed, encoder);
+            }
+        }
+
+        // Same as IOption::WriteValue() of the built-in option and positional argument types
+        void WriteValue(size_t id, const ValueRecord& value, ResultEncoder& encoder) const
+        {
+            const ValueState& state = m_Values[id];
+            const bool hasValue = state.WasParsed || value.HasDefault;
+            switch (value.Type) {
+            case SchemaEntry::Kind::Flag:
+                encoder.WriteBool(state.IsFlagSet ? state.Flag : value.DefaultInt != 0);
+                break;
+            case SchemaEntry::Kind::Int:
+                if (hasValue)
+                    encoder.WriteInt(state.WasParsed ? state.Int : value.DefaultInt);
+                break;
+            case SchemaEntry::Kind::Choice:
+                if (hasValue) {
+                    const int64_t choiceIdx = state.WasParsed ? state.Int : value.DefaultInt;
+                    encoder.WriteString(value.Choices.Length == 0 ? std::string_view()
+                        : m_Schema.ReadString(m_Schema.ReadAt<Span>(value.Choices, static_cast<size_t>(choiceIdx))));
+                }
+                break;
+            case SchemaEntry::Kind::Collection:
+            case SchemaEntry::Kind::VarArgument: {
+                auto item = std::lower_bound(m_Items.begin(), m_Items.end(), static_cast<uint32_t>(id),
+                    [](const auto& a, uint32_t b) { return a.first < b; });
+                std::vector<std::string_view> strings;
+                for (; item != m_Items.end() && item->first == id; ++item)
+                    strings.push_back(item->second);
+                encoder.WriteStrings(strings);
+                break;
+            }
+            default:
+                if (hasValue)
+                    encoder.WriteString(state.WasParsed ? state.String : m_Schema.ReadString(value.DefaultString));
+                break;
+            }
+        }
+
+    private:
+        const SchemaView& m_Schema;
+        std::vector<std::string_view>* m_PassThrough;
+        std::string m_Error;
+
+        std::vector<ValueState> m_Values;
+        std::vector<bool> m_IsCommandUsed;
+        // Values of collections and variadic arguments, by ID once parsing is over
+        std::vector<std::pair<uint32_t, std::string_view>> m_Items;
+        std::vector<std::unique_ptr<std::string>> m_KeptWords;
+    };
+
+    // A command of a SchemaView as seen by the parse loop and the help layout
+    class ImageCommand final :
+        public ICommandSchema
+    {
+    public:
+        using Span = SchemaView::Span;
+        using ValueRecord = SchemaView::ValueRecord;
+        using CommandRecord = SchemaView::CommandRecord;
+        using NameRecord = SchemaView::NameRecord;
+
+        // Only help is written if `parser` is nullptr
+        ImageCommand(const SchemaView& schema, size_t cmdIdx, SchemaParser* parser=nullptr) :
+            m_Schema(schema),
+            m_CmdIdx(cmdIdx),
+            m_Cmd(schema.ReadCommand(cmdIdx)),
+            m_Parser(parser)
+        {}
+
+        // Same as IArgParser::Parse(), `args` starts with the name of the command, which is not checked
+        bool Parse(std::stack<std::string_view>& args)
+        {
+            m_Parser->SetUsed(m_CmdIdx);
+            ParseState state;
+            PopWord(state, args);
+            return ParseCommandWords(*this, state, args);
+        }
+
+        std::string_view GetName() const override { return m_Schema.ReadString(m_Cmd.Name); }
+        std::string_view GetDescription() const override { return m_Schema.ReadString(m_Cmd.Description); }
+        std::string_view GetPrefix() const override { return m_Schema.m_Prefix; }
+        std::string_view GetShortPrefix() const override { return m_Schema.m_ShortPrefix; }
+        bool HasShortPrefix() const override { return !m_Schema.m_ShortPrefix.empty(); }
+
+        size_t GetOptionCount() const override { return m_Cmd.OptionCount; }
+        std::string_view GetOptionName(size_t idx) const override { return m_Schema.ReadString(ReadOption(idx).Name); }
+        std::string_view GetOptionShortName(size_t idx) const override { return m_Schema.ReadString(ReadOption(idx).ShortName); }
+        bool OptionHasMetaVar(size_t idx) const override { return ReadOption(idx).MetaVar.Length > 0; }
+        bool IsVarOptionalOption(size_t idx) const override { return ReadOption(idx).IsVarOptional; }
+        bool OptionHasValue(size_t idx) const override
+        {
+            return m_Parser->WasParsed(m_Cmd.FirstOption + idx) || ReadOption(idx).HasDefault;
+        }
+
+        size_t GetArgumentCount() const override { return m_Cmd.ArgumentCount; }
+        std::string_view GetArgumentMetaVar(size_t idx) const override { return m_Schema.ReadString(ReadArgument(idx).MetaVar); }
+        bool IsVariadicArgument(size_t idx) const override { return ReadArgument(idx).Type == SchemaEntry::Kind::VarArgument; }
+        bool ArgumentHasValue(size_t idx) const override
+        {
+            return m_Parser->WasParsed(m_Cmd.FirstArgument + idx) || ReadArgument(idx).HasDefault;
+        }
+
+        size_t GetSubCommandCount() const override { return m_Cmd.SubCommands.Length; }
+        std::string_view GetSubCommandName(size_t idx) const override { return m_Schema.ReadString(ReadSubCommand(idx).Name); }
+
+        size_t FindSubCommand(std::string_view name) const override { return FindName(m_Cmd.CommandNames, name); }
+        size_t FindUniqueSubCommand(std::string_view name, std::string& match) const override
+        {
+            return FindUniqueName(m_Cmd.CommandNames, name, match);
+        }
+        size_t FindOption(std::string_view name) const override { return FindName(m_Cmd.OptionNames, name); }
+        size_t FindUniqueOption(std::string_view name, std::string& match) const override
+        {
+            return FindUniqueName(m_Cmd.OptionNames, name, match);
+        }
+        // Short names starting with the byte follow the one which is a single byte, if any
+        size_t FindShortOption(char shortName) const override
+        {
+            size_t idx = LowerBound(m_Cmd.ShortNames, std::string_view(&shortName, 1));
+            size_t index = NameTrie::NPOS;
+            for (; idx < m_Cmd.ShortNames.Length; ++idx) {
+                const NameRecord record = m_Schema.ReadAt<NameRecord>(m_Cmd.ShortNames, idx);
+                const std::string_view name = m_Schema.ReadString(record.Name);
+                if (name.front() != shortName)
+                    break;
+                if (name.length() > 1)
+                    return NameTrie::AMBIGUOUS;
+                index = record.Index;
+            }
+            return index;
+        }
+        void FindOptionPrefixesOf(std::string_view arg, std::vector<size_t>& indices) const override
+        {
+            FindPrefixesOf(m_Cmd.OptionNames, arg, indices);
+        }
+        void FindShortOptionPrefixesOf(std::string_view arg, std::vector<size_t>& indices) const override
+        {
+            FindPrefixesOf(m_Cmd.ShortNames, arg, indices);
+        }
+        void AppendCustomOptions(std::vector<size_t>& indices) const override
+        {
+            for (size_t i = 0; i < m_Cmd.CustomOptions.Length; ++i)
+                indices.push_back(m_Schema.ReadAt<uint32_t>(m_Cmd.CustomOptions, i));
+        }
+        // Parsers of custom words are not encoded, see SchemaEncoder
+        size_t GetCustomSubCommandCount() const override { return 0; }
+        size_t GetCustomSubCommand(size_t) const override { return NameTrie::NPOS; }
+        const NameTrie& GetSubCommandNames() const override { return BuildNames(m_CommandNames, m_Cmd.CommandNames); }
+        const NameTrie& GetOptionNames() const override { return BuildNames(m_OptionNames, m_Cmd.OptionNames); }
+        void FindSubCommandsWithPrefix(std::string_view prefix, std::vector<NameTrie::Match>& matches) const override
+        {
+            FindWithPrefix(m_Cmd.CommandNames, prefix, matches);
+        }
+        void FindOptionsWithPrefix(std::string_view prefix, std::vector<NameTrie::Match>& matches) const override
+        {
+            FindWithPrefix(m_Cmd.OptionNames, prefix, matches);
+        }
+        void CompleteOptionValue(size_t idx, std::string_view prefix, std::vector<std::string>& candidates) const override
+        {
+            const Span completions = ReadOption(idx).Completions;
+            for (size_t i = 0; i < completions.Length; ++i) {
+                const std::string_view value = m_Schema.ReadString(m_Schema.ReadAt<Span>(completions, i));
+                if (value.starts_with(prefix))
+                    candidates.emplace_back(value);
+            }
+        }
+        void CompleteSubCommand(
+                size_t idx,
+                const std::vector<std::string_view>& words,
+                size_t wordIdx,
+                std::string_view word,
+                std::vector<std::string>& candidates) const override
+        {
+            const ImageCommand sub(m_Schema, m_Schema.ReadAt<uint32_t>(m_Cmd.SubCommands, idx));
+            CompleteCommandWords(sub, words, wordIdx, word, candidates);
+        }
+
+        void WriteHint(ITextBuilder& hint) const override { m_Schema.WriteText(hint, m_Cmd.Hint); }
+        void WriteOptionHint(size_t idx, ITextBuilder& hint) const override { m_Schema.WriteText(hint, ReadOption(idx).Hint); }
+        void WriteOptionHelp(size_t idx, ITextBuilder& help) const override { m_Schema.WriteText(help, ReadOption(idx).Help); }
+        bool ArgumentHasDescription(size_t idx) const override { return ReadArgument(idx).Description.Length > 0; }
+        void WriteArgumentHelp(size_t idx, ITextBuilder& help) const override { m_Schema.WriteText(help, ReadArgument(idx).Help); }
+        void WriteSubCommandHint(size_t idx, ITextBuilder& hint) const override { m_Schema.WriteText(hint, ReadSubCommand(idx).Hint); }
+        void WriteSubCommandHelp(size_t idx, ITextBuilder& help, bool briefOptions, bool briefSubcommands) const override
+        {
+            const ImageCommand sub(m_Schema, m_Schema.ReadAt<uint32_t>(m_Cmd.SubCommands, idx));
+            WriteCommandHelp(sub, help, briefOptions, briefSubcommands);
+        }
+
+    public:
+        bool HasError() const override { return m_Parser->HasError(); }
+        bool SetError(std::string&& errorMessage) override { return m_Parser->SetError(std::move(errorMessage)); }
+        bool PassThrough(std::string_view arg) override { return m_Parser->PassThrough(arg); }
+        std::string_view KeepWord(std::string&& word) override { return m_Parser->KeepWord(std::move(word)); }
+        // Images have no observers
+        void PopWord(const ParseState&, std::stack<std::string_view>& args) override { args.pop(); }
+
+        bool ParseOption(size_t idx, std::string_view arg, bool isShort) override
+        {
+            return m_Parser->ParseOption(m_Cmd.FirstOption + idx, arg, isShort);
+        }
+        bool ParseArgument(size_t idx, std::string_view arg) override
+        {
+            return m_Parser->ParseArgument(m_Cmd.FirstArgument + idx, arg);
+        }
+        bool ParseSubCommand(size_t idx, std::stack<std::string_view>& args) override
+        {
+            ImageCommand sub(m_Schema, m_Schema.ReadAt<uint32_t>(m_Cmd.SubCommands, idx), m_Parser);
+            return sub.Parse(args);
+        }
+        bool Finalize() override { return CheckCommandValues(*this) && !HasError(); }
+
+    private:
+        ValueRecord ReadOption(size_t idx) const { return m_Schema.ReadValue(m_Cmd.FirstOption + idx); }
+        ValueRecord ReadArgument(size_t idx) const { return m_Schema.ReadValue(m_Cmd.FirstArgument + idx); }
+        CommandRecord ReadSubCommand(size_t idx) const { return m_Schema.ReadCommand(m_Schema.ReadAt<uint32_t>(m_Cmd.SubCommands, idx)); }
+
+        // Same as NameTrie::Find(), names are sorted
+        size_t FindName(Span names, std::string_view name) const
+        {
+            const size_t idx = LowerBound(names, name);
+            if (idx < names.Length) {
+                const NameRecord record = m_Schema.ReadAt<NameRecord>(names, idx);
+                if (m_Schema.ReadString(record.Name) == name)
+                    return record.Index;
+            }
+            return NameTrie::NPOS;
+        }
+
+        // Same as NameTrie::FindUnique(), names starting with `name` follow it
+        size_t FindUniqueName(Span names, std::string_view name, std::string& match) const
+        {
+            match.clear();
+            size_t idx = LowerBound(names, name);
+            if (idx >= names.Length)
+                return NameTrie::NPOS;
+
+            NameRecord record = m_Schema.ReadAt<NameRecord>(names, idx);
+            const std::string_view first = m_Schema.ReadString(record.Name);
+            if (!first.starts_with(name))
+                return NameTrie::NPOS;
+
+            const size_t index = record.Index;
+            if (first != name) {
+                while (++idx < names.Length) {
+                    record = m_Schema.ReadAt<NameRecord>(names, idx);
+                    if (!m_Schema.ReadString(record.Name).starts_with(name))
+                        break;
+                    if (record.Index != index)
+                        return NameTrie::AMBIGUOUS;
+                }
+            }
+
+            match = first;
+            return index;
+        }
+
+        // Same as NameTrie::FindWithPrefix(), names starting with `prefix` follow it
+        void FindWithPrefix(Span names, std::string_view prefix, std::vector<NameTrie::Match>& matches) const
+        {
+            for (size_t idx = LowerBound(names, prefix); idx < names.Length; ++idx) {
+                const NameRecord record = m_Schema.ReadAt<NameRecord>(names, idx);
+                const std::string_view name = m_Schema.ReadString(record.Name);
+                if (!name.starts_with(prefix))
+                    break;
+                matches.push_back({ std::string(name), record.Index });
+            }
+        }
+
+        // Same as NameTrie::FindPrefixesOf(), each prefix is looked up
+        void FindPrefixesOf(Span names, std::string_view name, std::vector<size_t>& indices) const
+        {
+            for (size_t length = 1; length <= name.length(); ++length) {
+                const size_t index = FindName(names, name.substr(0, length));
+                if (index != NameTrie::NPOS)
+                    indices.push_back(index);
+            }
+        }
+
+        // The index of the first name which is not less than `name`
+        size_t LowerBound(Span names, std::string_view name) const
+        {
+            size_t first = 0, count = names.Length;
+            while (count > 0) {
+                const size_t step = count / 2;
+                const NameRecord record = m_Schema.ReadAt<NameRecord>(names, first + step);
+                if (m_Schema.ReadString(record.Name) < name) {
+                    first += step + 1;
+                    count -= step + 1;
+                } else count = step;
+            }
+            return first;
+        }
+
+        // Tries are only built for error messages
+        const NameTrie& BuildNames(const LazyValue<NameTrie>& trie, Span names) const
+        {
+            return trie.Get([&](NameTrie& built) {
+                for (size_t i = 0; i < names.Length; ++i) {
+                    const NameRecord record = m_Schema.ReadAt<NameRecord>(names, i);
+                    built.Insert(m_Schema.ReadString(record.Name), record.Index);
+                }
+            });
+        }
+
+    private:
+        const SchemaView& m_Schema;
+        size_t m_CmdIdx;
+        CommandRecord m_Cmd;
+        SchemaParser* m_Parser;
+        LazyValue<NameTrie> m_OptionNames;
+        LazyValue<NameTrie> m_CommandNames;
+    };
 }
 
-void Argue::IOption::WriteHelp(ITextBuilder& help) const
+std::string Argue::EncodeSchema(const ArgParser& parser)
 {
-    WriteHint(help);
-    if (HasDescription()) {
-        help.NewLine();
-        help.Indent();
-        help.PutText(GetDescription());
-        help.DeIndent();
+    return SchemaEncoder().Encode(parser);
+}
+
+uint64_t Argue::FingerprintSchema(std::string_view image)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (char ch : image) {
+        hash ^= static_cast<uint8_t>(ch);
+        hash *= 0x100000001b3ull;
     }
+    return hash;
 }
 
-bool Argue::IOption::ParseArg(std::string_view arg, bool isShort)
+template<typename Record>
+Record Argue::SchemaView::Read(uint64_t offset) const
 {
-    if (!ConsumeName(arg, isShort))
+    Record record;
+    std::memcpy(&record, m_Data.data() + offset, sizeof(record));
+    return record;
+}
+
+Argue::SchemaView::ValueRecord Argue::SchemaView::ReadValue(size_t id) const
+{
+    return Read<ValueRecord>(sizeof(Header) + id * sizeof(ValueRecord));
+}
+
+Argue::SchemaView::CommandRecord Argue::SchemaView::ReadCommand(size_t idx) const
+{
+    return Read<CommandRecord>(sizeof(Header) + m_ValueCount * sizeof(ValueRecord) + idx * sizeof(CommandRecord));
+}
+
+std::string_view Argue::SchemaView::GetName() const
+{
+    if (IsEmpty())
+        return "";
+    return ReadString(ReadCommand(0).Name);
+}
+
+bool Argue::SchemaView::Attach(std::string_view image)
+{
+    *this = SchemaView();
+
+    Header header;
+    if (image.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, image.data(), sizeof(header));
+
+    const uint64_t recordsSize = sizeof(header)
+        + uint64_t(header.ValueCount) * sizeof(ValueRecord)
+        + uint64_t(header.CommandCount) * sizeof(CommandRecord);
+    if (header.Magic != SCHEMA_MAGIC
+            || header.Version != VERSION
+            || header.Size > image.size()
+            || recordsSize > header.Size
+            || header.CommandCount == 0) {
+        return false;
+    }
+
+    // Records are read through the view while it's checked
+    SchemaView view;
+    view.m_Data = image.substr(0, header.Size);
+    view.m_ValueCount = header.ValueCount;
+    view.m_CommandCount = header.CommandCount;
+    if (!view.CheckSpan(header.Prefix, 1) || !view.CheckSpan(header.ShortPrefix, 1))
         return false;
 
-    if (!isShort && HasMetaVar()) {
-        if (!arg.starts_with('='))
+    for (size_t id = 0; id < view.m_ValueCount; ++id) {
+        if (!view.CheckValue(view.ReadValue(id)))
             return false;
-        arg.remove_prefix(1);
     }
 
-    return ParseValue(arg);
+    uint32_t nextId = 0;
+    std::vector<bool> isVisited(view.m_CommandCount, false);
+    if (!view.CheckCommand(0, NONE, 0, nextId, isVisited) || nextId != view.m_ValueCount)
+        return false;
+
+    view.m_Prefix = view.ReadString(header.Prefix);
+    view.m_ShortPrefix = view.ReadString(header.ShortPrefix);
+    *this = view;
+    return true;
 }
 
-bool Argue::IOption::SetError(std::string&& errorMessage)
+bool Argue::SchemaView::CheckSpan(Span list, size_t recordSize) const
 {
-    return m_Parser.SetError(std::forward<std::string>(errorMessage));
+    // Lists of records are aligned like they were encoded, strings may be anywhere
+    if (recordSize > 1 && list.Offset % 4 != 0)
+        return false;
+    return uint64_t(list.Offset) + uint64_t(list.Length) * recordSize <= m_Data.size();
 }
 
-bool Argue::IOption::ConsumeName(std::string_view& arg, bool isShort)
+bool Argue::SchemaView::CheckValue(const ValueRecord& value) const
 {
-    if (isShort) {
-        if (!HasShortName() || !arg.starts_with(GetShortName()))
+    if (value.Type > SchemaEntry::Kind::VarArgument)
+        return false;
+
+    const Span strings[] = { value.Key, value.Name, value.ShortName, value.MetaVar, value.Description, value.DefaultString };
+    for (Span str : strings) {
+        if (!CheckSpan(str, 1))
+            return false;
+    }
+
+    if (!CheckSpan(value.Aliases, sizeof(Span))
+            || !CheckSpan(value.Choices, sizeof(Span))
+            || !CheckSpan(value.Linked, sizeof(uint32_t))
+            || !CheckSpan(value.Completions, sizeof(Span))) {
+        return false;
+    }
+    if (!CheckText(value.Hint) || !CheckText(value.Help))
+        return false;
+    for (size_t i = 0; i < value.Aliases.Length; ++i) {
+        if (!CheckSpan(ReadAt<Span>(value.Aliases, i), 1))
+            return false;
+    }
+    for (size_t i = 0; i < value.Choices.Length; ++i) {
+        if (!CheckSpan(ReadAt<Span>(value.Choices, i), 1))
+            return false;
+    }
+    for (size_t i = 0; i < value.Completions.Length; ++i) {
+        if (!CheckSpan(ReadAt<Span>(value.Completions, i), 1))
+            return false;
+    }
+    if (value.Type == SchemaEntry::Kind::Choice && value.Choices.Length > 0
+            && (value.DefaultInt < 0 || static_cast<uint64_t>(value.DefaultInt) >= value.Choices.Length)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < value.Linked.Length; ++i) {
+        const uint32_t linked = ReadAt<uint32_t>(value.Linked, i);
+        if (linked >= m_ValueCount)
+            return false;
+        const ValueRecord linkedValue = ReadValue(linked);
+        if (linkedValue.Command != NONE || linkedValue.Type != SchemaEntry::Kind::Flag)
+            return false;
+    }
+    return true;
+}
+
+bool Argue::SchemaView::CheckCommand(size_t idx, uint32_t id, size_t depth, uint32_t& nextId, std::vector<bool>& isVisited) const
+{
+    if (idx >= m_CommandCount || isVisited[idx] || depth > MAX_SCHEMA_DEPTH)
+        return false;
+    isVisited[idx] = true;
+
+    const CommandRecord cmd = ReadCommand(idx);
+    if (cmd.Id != id
+            || !CheckSpan(cmd.Name, 1)
+            || !CheckSpan(cmd.Description, 1)
+            || !CheckSpan(cmd.SubCommands, sizeof(uint32_t))
+            || !CheckSpan(cmd.CustomOptions, sizeof(uint32_t))
+            || !CheckText(cmd.Hint)) {
+        return false;
+    }
+
+    if (cmd.FirstOption != nextId || uint64_t(cmd.OptionCount) + cmd.ArgumentCount > m_ValueCount - nextId)
+        return false;
+    for (; nextId < cmd.FirstOption + cmd.OptionCount; ++nextId) {
+        const ValueRecord opt = ReadValue(nextId);
+        if (opt.Command != NONE || opt.Type > SchemaEntry::Kind::Collection)
+            return false;
+    }
+
+    if (cmd.FirstArgument != nextId)
+        return false;
+    for (; nextId < cmd.FirstArgument + cmd.ArgumentCount; ++nextId) {
+        const ValueRecord arg = ReadValue(nextId);
+        if (arg.Command != NONE || arg.Type < SchemaEntry::Kind::Argument)
             return false;
-        arg.remove_prefix(GetShortName().length());
-        return true;
     }
 
-    if (!arg.starts_with(GetName()))
+    if (!CheckNames(cmd.OptionNames, cmd.OptionCount)
+            || !CheckNames(cmd.CommandNames, cmd.SubCommands.Length)
+            || !CheckNames(cmd.ShortNames, cmd.OptionCount)) {
         return false;
-    arg.remove_prefix(GetName().length());
+    }
+    for (size_t i = 0; i < cmd.CustomOptions.Length; ++i) {
+        if (ReadAt<uint32_t>(cmd.CustomOptions, i) >= cmd.OptionCount)
+            return false;
+    }
+
+    for (size_t i = 0; i < cmd.SubCommands.Length; ++i) {
+        const uint32_t subIdx = ReadAt<uint32_t>(cmd.SubCommands, i);
+        const uint32_t subId = nextId++;
+        if (subId >= m_ValueCount || ReadValue(subId).Command != subIdx)
+            return false;
+        if (!CheckCommand(subIdx, subId, depth+1, nextId, isVisited))
+            return false;
+    }
     return true;
 }
 
-Argue::IPositionalArgument::IPositionalArgument(IArgParser& parser, std::string_view metaVar, std::string_view description) :
-    m_Parser(parser),
-    m_MetaVar(metaVar),
-    m_Description(description)
+bool Argue::SchemaView::CheckNames(Span names, size_t count) const
 {
-    m_Parser.AddArgument(*this);
+    if (!CheckSpan(names, sizeof(NameRecord)))
+        return false;
+    for (size_t i = 0; i < names.Length; ++i) {
+        const NameRecord name = ReadAt<NameRecord>(names, i);
+        if (!CheckSpan(name.Name, 1) || name.Index >= count)
+            return false;
+    }
+    return true;
 }
 
-void Argue::IPositionalArgument::WriteHint(ITextBuilder& hint) const
+bool Argue::SchemaView::CheckText(Span text) const
 {
-    if (HasDefaultValue()) {
-        if (IsVariadic()) {
-            hint.PutText(s("[...", GetMetaVar(), ']'));
-        } else{
-            hint.PutText(s('[', GetMetaVar(), ']'));
-        }
-    } else {
-        hint.PutText(s('<', GetMetaVar(), '>'));
+    if (!CheckSpan(text, sizeof(TextRecord)))
+        return false;
+    for (size_t i = 0; i < text.Length; ++i) {
+        const TextRecord record = ReadAt<TextRecord>(text, i);
+        if (record.Method > TextRecord::Call::DeIndent || !CheckSpan(record.Text, 1))
+            return false;
     }
+    return true;
 }
 
-void Argue::IPositionalArgument::WriteHelp(ITextBuilder& help) const
+bool Argue::SchemaView::Parse(
+        const std::vector<std::string_view>& args,
+        ParseResult& result,
+        std::vector<std::string_view>* passThrough) const
 {
-    if (IsVariadic()) {
-        help.PutText(s("...", GetMetaVar(), ':'));
-    } else {
-        help.PutText(s(GetMetaVar(), ':'));
+    if (IsEmpty()) {
+        result.Assign(std::string());
+        return false;
     }
-    if (HasDescription()) {
-        help.NewLine();
-        help.Indent();
-        help.PutText(GetDescription());
-        help.DeIndent();
+
+    SchemaParser parser(*this, passThrough);
+    if (!args.empty()) {
+        std::stack<std::string_view> stack;
+        for (size_t i = args.size(); i > 0; --i)
+            stack.push(args[i-1]);
+        ImageCommand(*this, 0, &parser).Parse(stack);
     }
+    result.Assign(parser.Encode());
+    return result.IsValid();
 }
 
-bool Argue::IPositionalArgument::SetError(std::string&& errorMessage)
+bool Argue::SchemaView::Parse(
+        int argc,
+        const char** argv,
+        ParseResult& result,
+        std::vector<std::string_view>* passThrough) const
 {
-    return m_Parser.SetError(std::forward<std::string>(errorMessage));
+    std::vector<std::string_view> args(argv, argv + argc);
+    return Parse(args, result, passThrough);
 }
 
-void Argue::IArgParser::WriteHint(ITextBuilder& hint) const
+void Argue::SchemaView::WriteText(ITextBuilder& builder, Span text) const
 {
-    if (m_Commands.size() > 0) {
-        std::string subcommands = m_Commands[0]->GetName();
-        for (size_t i = 1; i < m_Commands.size(); ++i) {
-            subcommands += '|';
-            subcommands += m_Commands[i]->GetName();
-        }
-
-        hint.PutText(GetName());
-        if (m_Options.size() > 0) {
-            hint.PutText(" [...OPTIONS]");
-        }
-        hint.PutText(s(" [", subcommands, " ...]"));
-    } else {
-        hint.PutText(GetName());
-        if (m_Options.size() > 0) {
-            hint.PutText(" [...OPTIONS]");
-        }
-    }
-    if (m_Arguments.size() > 0) {
-        hint.PutText(" [--]");
-        for (const IPositionalArgument* arg : m_Arguments) {
-            hint.PutText(" ");
-            arg->WriteHint(hint);
+    for (size_t i = 0; i < text.Length; ++i) {
+        const TextRecord record = ReadAt<TextRecord>(text, i);
+        switch (record.Method) {
+        case TextRecord::Call::PutText: builder.PutText(ReadString(record.Text)); break;
+        case TextRecord::Call::NewLine: builder.NewLine(); break;
+        case TextRecord::Call::Spacer: builder.Spacer(); break;
+        case TextRecord::Call::Indent: builder.Indent(); break;
+        case TextRecord::Call::DeIndent: builder.DeIndent(); break;
         }
     }
 }
 
-void Argue::IArgParser::WriteHelp(ITextBuilder& help, bool briefOptions, bool briefSubcommands) const
+void Argue::SchemaView::WriteHelp(ITextBuilder& help, bool briefOptions, bool briefSubcommands) const
 {
-    WriteHint(help);
-    help.Spacer();
+    if (!IsEmpty())
+        WriteCommandHelp(ImageCommand(*this, 0), help, briefOptions, briefSubcommands);
+}
 
-    if (HasDescription()) {
-        help.Indent();
-        help.PutText(GetDescription());
-        help.DeIndent();
-        help.Spacer();
-    }
+void Argue::SchemaView::Complete(const std::vector<std::string_view>& words, std::string_view word, std::vector<std::string>& candidates) const
+{
+    if (!IsEmpty())
+        CompleteCommandWords(ImageCommand(*this, 0), words, 1, word, candidates);
+}
 
-    for (const IPositionalArgument* arg : m_Arguments) {
-        if (arg->HasDescription()) {
-            arg->WriteHelp(help);
-            help.Spacer();
-        }
-    }
+namespace Argue
+{
+    // Writes the source of GenerateSchemaSource()
+    class SchemaSourceWriter
+    {
+    public:
+        using Span = SchemaView::Span;
+        using ValueRecord = SchemaView::ValueRecord;
 
-    if (m_Options.size() > 0) {
-        help.PutText("OPTIONS:");
-        help.NewLine();
-        if (briefOptions) {
-            for (const IOption* opt : m_Options) {
-                help.Indent();
-                opt->WriteHint(help);
-                help.DeIndent();
-                help.NewLine();
-            }
-            help.Spacer();
-        } else {
-            for (const IOption* opt : m_Options) {
-                help.Indent();
-                opt->WriteHelp(help);
-                help.DeIndent();
-                help.Spacer();
-            }
-        }
-    }
+        SchemaSourceWriter(const SchemaView& schema) :
+            m_Schema(schema)
+        {}
 
-    if (m_Commands.size() > 0) {
-        help.PutText("SUBCOMMANDS:");
-        help.NewLine();
-        if (briefSubcommands) {
-            for (const IArgParser* cmd : m_Commands) {
-                help.Indent();
-                cmd->WriteHint(help);
-                help.DeIndent();
-                help.NewLine();
-            }
-            help.Spacer();
-        } else {
-            for (const IArgParser* cmd : m_Commands) {
-                help.Indent();
-                cmd->WriteHelp(help, briefOptions, briefSubcommands);
-                help.DeIndent();
-                help.Spacer();
-            }
+        std::string Write(std::string_view ns)
+        {
+            m_Source = s(
+                "// Generated by Argue::GenerateSchemaSource(), do not edit\n"
+                "#pragma once\n"
+                "\n"
+                "#include \"argue.hpp\"\n"
+                "\n"
+                "namespace ", ns, "\n"
+                "{\n");
+            WriteImage();
+            WriteHelp();
+            WriteValues();
+            WriteFunctions();
+            m_Source += "}\n";
+            return std::move(m_Source);
         }
-    }
-}
-
-bool Argue::IArgParser::Parse(std::stack<std::string_view> args)
-{
-    if (args.top() != GetName())
-        return false;
-    args.pop();
 
-    const bool arePrefixesTheSame = GetShortPrefix() == GetPrefix();
+    private:
+        struct Field
+        {
+            std::string Name;
+            ResultView::ValueType Type;
+        };
 
-    m_WasUsed = true;
-    bool isParsingPositionals = false;
-    size_t positionalIdx = 0;
-    for (; !args.empty(); args.pop()) {
-        std::string_view argWithPrefix = args.top();
-        std::string_view arg = argWithPrefix;
-
-        if (isParsingPositionals) {
-            if (positionalIdx >= m_Arguments.size())
-                return SetError(s("Unexpected positional argument '", argWithPrefix, "'."));
-            IPositionalArgument* positional = m_Arguments[positionalIdx];
-            if (!positional->Parse(arg))
-                return false;
-            if (!positional->IsVariadic())
-                ++positionalIdx;
-            continue;
+        void WriteImage()
+        {
+            static constexpr char DIGITS[] = "0123456789abcdef";
+
+            m_Source +=
+                "    // The schema image, its records and sorted names are read in place\n"
+                "    alignas(8) inline constexpr unsigned char SCHEMA_IMAGE[] = {";
+            for (size_t i = 0; i < m_Schema.m_Data.size(); ++i) {
+                const auto byte = static_cast<uint8_t>(m_Schema.m_Data[i]);
+                m_Source += i % 16 == 0 ? "\n        0x" : " 0x";
+                m_Source += DIGITS[byte >> 4];
+                m_Source += DIGITS[byte & 0xF];
+                m_Source += ',';
+            }
+            m_Source += "\n    };\n\n";
+
+            const uint64_t fingerprint = FingerprintSchema(m_Schema.m_Data);
+            m_Source +=
+                "    // See Argue::FingerprintSchema(), e.g. for Argue::RequestParse()\n"
+                "    inline constexpr uint64_t FINGERPRINT = 0x";
+            for (int shift = 60; shift >= 0; shift -= 4)
+                m_Source += DIGITS[(fingerprint >> shift) & 0xF];
+            m_Source += "ull;\n\n";
         }
 
-        if (arg == "--") {
-            isParsingPositionals = true;
-            continue;
+        void WriteHelp()
+        {
+            TextBuilder help;
+            m_Schema.WriteHelp(help);
+            const std::string text = help.Build();
+
+            m_Source +=
+                "    // The help written by a default Argue::TextBuilder, see WriteHelp()\n"
+                "    inline constexpr std::string_view HELP =";
+            // A literal per line, compilers limit the length of each literal
+            size_t start = 0;
+            do {
+                const size_t newLine = text.find('\n', start);
+                const size_t end = newLine == std::string::npos ? text.size() : newLine + 1;
+                m_Source += "\n        ";
+                AppendLiteral(std::string_view(text).substr(start, end - start));
+                start = end;
+            } while (start < text.size());
+            m_Source += ";\n\n";
         }
 
-        bool isShortPrefix = false;
-        if (arg.starts_with(GetPrefix())) {
-            arg.remove_prefix(GetPrefix().length());
-            isShortPrefix = false;
-        } else if (HasShortPrefix() && arg.starts_with(GetShortPrefix())) {
-            arg.remove_prefix(GetShortPrefix().length());
-            isShortPrefix = true;
-        } else {
-            // Try Parse Commands
-            for (IArgParser* cmd : m_Commands) {
-                if (cmd->Parse(args))
-                    return CheckOptionsAndArguments() && !HasError();
-                if (cmd->HasError())
-                    return false;
+        void WriteValues()
+        {
+            // Names which can't be fields as is
+            static const std::unordered_set<std::string_view> RESERVED = {
+                "Values", "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+                "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "co_await", "co_return",
+                "co_yield", "compl", "concept", "const", "const_cast", "consteval", "constexpr", "constinit",
+                "continue", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+                "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int",
+                "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+                "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return",
+                "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+                "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+                "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+            };
+
+            std::unordered_set<std::string> names;
+            m_Source +=
+                "    // A field per value of the schema, see ReadValues()\n"
+                "    struct Values\n"
+                "    {\n";
+            for (size_t id = 0; id < m_Schema.m_ValueCount; ++id) {
+                const ValueRecord value = m_Schema.ReadValue(id);
+                const std::string_view key = m_Schema.ReadString(value.Key);
+                std::string name = MakeIdentifier(key);
+                if (RESERVED.count(name) != 0)
+                    name += '_';
+
+                // Keys may only differ by characters which were replaced, e.g. "a-b" and "a_b"
+                Field field{ name, GetResultType(value) };
+                for (size_t n = 2; !names.insert(field.Name).second; ++n)
+                    field.Name = s(name, name.back() == '_' ? "" : "_", std::to_string(n));
+
+                m_Source += "        ";
+                WriteField(value, field);
+                if (field.Name != key) {
+                    m_Source += " // ";
+                    AppendLiteral(key);
+                }
+                m_Source += '\n';
+                m_Fields.push_back(std::move(field));
             }
-
-            // Duplicate arg so that it will be parsed on the next iteration as positional
-            isParsingPositionals = true;
-            args.push(args.top());
-            continue;
+            m_Source += "    };\n\n";
         }
 
-        // Parse options
-        bool hasParsedOption = false;
-        for (IOption* opt : m_Options) {
-            if (opt->Parse(arg, isShortPrefix)) {
-                hasParsedOption = true;
+        // Declares the field initialized to the default value
+        void WriteField(const ValueRecord& value, const Field& field)
+        {
+            switch (field.Type) {
+            case ResultView::ValueType::Bool:
+                m_Source += s("bool ", field.Name, " = ",
+                    value.Command == SchemaView::NONE && value.DefaultInt != 0 ? "true;" : "false;");
+                break;
+            case ResultView::ValueType::Int:
+                m_Source += s("int64_t ", field.Name, " = ");
+                if (!value.HasDefault) {
+                    m_Source += '0';
+                } else if (value.DefaultInt == INT64_MIN) {
+                    // Its literal would be the negation of a number which does not fit
+                    m_Source += "INT64_MIN";
+                } else m_Source += std::to_string(value.DefaultInt);
+                m_Source += ';';
+                break;
+            case ResultView::ValueType::String:
+                m_Source += s("std::string_view ", field.Name);
+                if (value.HasDefault && value.Type != SchemaEntry::Kind::Choice) {
+                    m_Source += " = ";
+                    AppendLiteral(m_Schema.ReadString(value.DefaultString));
+                } else if (value.HasDefault && value.Choices.Length > 0) {
+                    m_Source += " = ";
+                    AppendLiteral(m_Schema.ReadString(
+                        m_Schema.ReadAt<Span>(value.Choices, static_cast<size_t>(value.DefaultInt))));
+                }
+                m_Source += ';';
+                break;
+            default:
+                m_Source += s("std::vector<std::string_view> ", field.Name, ';');
                 break;
             }
+        }
 
-            if (HasError())
-                return false;
-
-            // If prefixes are equal, long prefix is preferred.
-            // Try parsing again but as if the short prefix was used.
-            if (arePrefixesTheSame) {
-                if (opt->Parse(arg, !isShortPrefix)) {
-                    hasParsedOption = true;
+        void WriteFunctions()
+        {
+            m_Source +=
+                "    // The view of SCHEMA_IMAGE, which is checked once\n"
+                "    inline const Argue::SchemaView& GetSchema()\n"
+                "    {\n"
+                "        static const Argue::SchemaView schema = [] {\n"
+                "            Argue::SchemaView view;\n"
+                "            view.Attach(std::string_view(reinterpret_cast<const char*>(SCHEMA_IMAGE), sizeof(SCHEMA_IMAGE)));\n"
+                "            return view;\n"
+                "        }();\n"
+                "        return schema;\n"
+                "    }\n"
+                "\n"
+                "    // Same as Argue::SchemaView::WriteHelp(), e.g. for builders which do not wrap like HELP\n"
+                "    inline void WriteHelp(Argue::ITextBuilder& help, bool briefOptions=false, bool briefSubcommands=true)\n"
+                "    {\n"
+                "        GetSchema().WriteHelp(help, briefOptions, briefSubcommands);\n"
+                "    }\n"
+                "\n"
+                "    // Reads the values which are present within a result of this schema, strings are views of it\n"
+                "    inline void ReadValues(const Argue::ResultView& result, Values& values)\n"
+                "    {\n";
+            if (m_Fields.empty())
+                m_Source += "        (void)result;\n        (void)values;\n";
+
+            for (size_t id = 0; id < m_Fields.size(); ++id) {
+                const std::string& name = m_Fields[id].Name;
+                const std::string idText = std::to_string(id);
+                switch (m_Fields[id].Type) {
+                case ResultView::ValueType::Bool:
+                    m_Source += s("        values.", name, " = result.GetBool(", idText, ", values.", name, ");\n");
+                    break;
+                case ResultView::ValueType::Int:
+                    m_Source += s("        values.", name, " = result.GetInt(", idText, ", values.", name, ");\n");
+                    break;
+                case ResultView::ValueType::String:
+                    m_Source += s("        values.", name, " = result.GetString(", idText, ", values.", name, ");\n");
+                    break;
+                default:
+                    m_Source += s(
+                        "        values.", name, ".clear();\n"
+                        "        for (size_t i = 0; i < result.GetStringCount(", idText, "); ++i)\n"
+                        "            values.", name, ".push_back(result.GetStringAt(", idText, ", i));\n");
                     break;
                 }
-
-                if (HasError())
-                    return false;
             }
-        }
 
-        if (!hasParsedOption) {
-            return SetError(s("Unknown option '", argWithPrefix, "'."));
+            m_Source +=
+                "    }\n"
+                "\n"
+                "    // Same as Argue::SchemaView::Parse(), `values` are read if the command line is valid\n"
+                "    inline bool Parse(\n"
+                "            int argc,\n"
+                "            const char** argv,\n"
+                "            Argue::ParseResult& result,\n"
+                "            Values& values,\n"
+                "            std::vector<std::string_view>* passThrough=nullptr)\n"
+                "    {\n"
+                "        if (!GetSchema().Parse(argc, argv, result, passThrough))\n"
+                "            return false;\n"
+                "        ReadValues(result, values);\n"
+                "        return true;\n"
+                "    }\n";
         }
-    }
 
-    return CheckOptionsAndArguments() && !HasError();
-}
+        // Same as the type of the value within results, see SchemaParser::WriteValue()
+        static ResultView::ValueType GetResultType(const ValueRecord& value)
+        {
+            if (value.Command != SchemaView::NONE)
+                return ResultView::ValueType::Bool;
+
+            switch (value.Type) {
+            case SchemaEntry::Kind::Flag:
+                return ResultView::ValueType::Bool;
+            case SchemaEntry::Kind::Int:
+                return ResultView::ValueType::Int;
+            case SchemaEntry::Kind::Collection:
+            case SchemaEntry::Kind::VarArgument:
+                return ResultView::ValueType::Strings;
+            default:
+                return ResultView::ValueType::String;
+            }
+        }
 
-bool Argue::IArgParser::CheckOptionsAndArguments()
-{
-    for (const IOption* opt : m_Options) {
-        if (!opt->HasValue()) {
-            return SetError(s("Missing option '", GetPrefix(), opt->GetName(), "' to '", GetName(), "'."));
+        // e.g. "install/dry-run" becomes "install_dry_run", it may be reserved
+        static std::string MakeIdentifier(std::string_view key)
+        {
+            std::string name;
+            for (char ch : key) {
+                const bool isAlnum = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9');
+                if (isAlnum) {
+                    name += ch;
+                } else if (!name.empty() && name.back() != '_') {
+                    // Names with two consecutive underscores are reserved
+                    name += '_';
+                }
+            }
+            if (name.empty() || (name[0] >= '0' && name[0] <= '9'))
+                name.insert(0, "v");
+            return name;
         }
-    }
 
-    for (const IPositionalArgument* arg : m_Arguments) {
-        if (!arg->HasValue()) {
-            return SetError(s("Missing argument '", arg->GetMetaVar(), "' to '", GetName(), "'."));
+        // Escapes everything but printable ASCII characters.
+        // Octal escapes always have three digits, so that the next character can't be read as a digit of theirs.
+        // Question marks which follow another one are escaped too, compilers warn about trigraphs (e.g. "??=").
+        void AppendLiteral(std::string_view text)
+        {
+            m_Source += '"';
+            for (size_t i = 0; i < text.size(); ++i) {
+                const char ch = text[i];
+                const auto byte = static_cast<uint8_t>(ch);
+                if (ch == '"' || ch == '\\' || (ch == '?' && i > 0 && text[i-1] == '?')) {
+                    m_Source += '\\';
+                    m_Source += ch;
+                } else if (ch == '\n') {
+                    m_Source += "\\n";
+                } else if (byte < 0x20 || byte >= 0x7F) {
+                    m_Source += '\\';
+                    m_Source += static_cast<char>('0' + (byte >> 6));
+                    m_Source += static_cast<char>('0' + ((byte >> 3) & 7));
+                    m_Source += static_cast<char>('0' + (byte & 7));
+                } else m_Source += ch;
+            }
+            m_Source += '"';
         }
-    }
 
-    return true;
+    private:
+        const SchemaView& m_Schema;
+        std::string m_Source;
+        std::vector<Field> m_Fields; // By ID
+    };
 }
 
-void Argue::FlagOption::WriteHint(ITextBuilder& hint) const
+std::string Argue::GenerateSchemaSource(const SchemaView& schema, std::string_view ns)
 {
-    const IArgParser& parser = GetParser();
-    if (parser.HasShortPrefix() && HasShortName()) {
-        hint.PutText(s(parser.GetPrefix(), GetName(), ", ", parser.GetShortPrefix(), GetShortName()));
-    } else {
-        hint.PutText(s(parser.GetPrefix(), GetName()));
-    }
+    if (schema.IsEmpty())
+        return "";
+    return SchemaSourceWriter(schema).Write(ns);
 }
 
-void Argue::FlagOption::WriteHelp(ITextBuilder& help) const
+#ifdef ARGUE_POSIX
+bool Argue::MappedFile::Open(const std::string& path)
 {
-    const IArgParser& parser = GetParser();
-
-    WriteHint(help);
-    help.PutText(", ");
-    if (parser.HasShortPrefix() && HasShortName())
-        help.NewLine();
-    help.PutText(s(GetParser().GetPrefix(), "no-", GetName()));
+    Close();
 
-    if (HasDescription()) {
-        help.NewLine();
-        help.Indent();
-        help.PutText(GetDescription());
-        help.DeIndent();
-    }
-}
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return SetError(s("Could not open '", path, "'"));
 
-bool Argue::FlagOption::ParseArg(std::string_view arg, bool isShort)
-{
-    if (ConsumeName(arg, isShort)) {
-        if (!arg.empty())
-            return false;
-        SetValue(true);
-        return true;
-    }
-    
-    if (isShort)
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        SetError(s("Could not map '", path, "'"));
+        close(fd);
         return false;
+    }
 
-    if (arg.starts_with("no-")) {
-        arg.remove_prefix(3);
-        if (arg != GetName())
+    // Empty files can't be mapped, their view is empty
+    const size_t size = static_cast<size_t>(status.st_size);
+    if (size > 0) {
+        m_Data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m_Data == MAP_FAILED) {
+            m_Data = nullptr;
+            SetError(s("Could not map '", path, "'"));
+            close(fd);
             return false;
-        SetValue(false);
-        return true;
+        }
+        m_Size = size;
     }
 
-    return false;
+    // The mapping stays valid once the file is closed
+    close(fd);
+    return true;
 }
 
-bool Argue::IntOption::ParseValue(std::string_view val)
+void Argue::MappedFile::Close()
 {
-    int64_t value = m_Default;
-    auto result = std::from_chars(&val.front(), &val.back()+1, value, 10);
-    if (result.ptr != &val.back()+1)
-        return SetError(s("Expected integer for '", GetParser().GetPrefix(), GetName(), "', got '", val, "'."));
-
-    m_Value = value;
-    return true;
+    if (m_Data != nullptr)
+        munmap(m_Data, m_Size);
+    m_Data = nullptr;
+    m_Size = 0;
 }
 
-bool Argue::StrOption::ParseValue(std::string_view val)
+bool Argue::MappedFile::SetError(std::string_view message)
 {
-    m_Value = val;
-    return true;
+    m_Error = s(message, ": ", std::strerror(errno), ".");
+    return false;
 }
+#endif // ARGUE_POSIX
 
-void Argue::ChoiceOption::WriteHint(ITextBuilder& hint) const
+bool Argue::ConfigFile::Open(const std::string& path)
 {
-    const IArgParser& parser = GetParser();
-    if (parser.HasShortPrefix() && HasShortName()) {
-        hint.PutText(s(
-            parser.GetPrefix(), GetName(), '=', GetChoiceString(), ", ",
-            parser.GetShortPrefix(), GetShortName(), GetChoiceString()
-        ));
-    } else {
-        hint.PutText(s(
-            parser.GetPrefix(), GetName(), '=', GetChoiceString()
-        ));
-    }
+    m_Entries.clear();
+#ifdef ARGUE_POSIX
+    if (!m_File.Open(path))
+        return SetError(std::string(m_File.GetError()));
+    return Load(m_File.GetData(), path);
+#else
+    std::ifstream file(path, std::ios::binary);
+    m_Text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (!file)
+        return SetError(s("Could not read '", path, "'."));
+    return Load(m_Text, path);
+#endif
 }
 
-bool Argue::ChoiceOption::ParseValue(std::string_view val)
+bool Argue::ConfigFile::Load(std::string_view text, std::string_view name)
 {
-    for (size_t i = 0; i < m_Choices.size(); ++i) {
-        if (m_Choices[i] == val) {
-            m_ValueIdx = i;
-            return true;
+    m_Name = name;
+    m_Error.clear();
+    m_Entries.clear();
+
+    auto trim = [](std::string_view str) {
+        while (!str.empty() && (str.front() == ' ' || str.front() == '\t'))
+            str.remove_prefix(1);
+        while (!str.empty() && (str.back() == ' ' || str.back() == '\t'))
+            str.remove_suffix(1);
+        return str;
+    };
+
+    // A BOM is written by some editors
+    if (text.starts_with("\xEF\xBB\xBF"))
+        text.remove_prefix(3);
+    // Files may be large, lines are counted once instead of growing the entries
+    m_Entries.reserve(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+
+    std::string_view section;
+    size_t lineNumber = 0;
+    while (!text.empty()) {
+        const size_t newLine = text.find('\n');
+        std::string_view line = text.substr(0, newLine);
+        text.remove_prefix(newLine == std::string_view::npos ? text.size() : newLine + 1);
+        ++lineNumber;
+
+        if (line.ends_with('\r'))
+            line.remove_suffix(1);
+        line = trim(line);
+        if (line.empty() || line.front() == '#' || line.front() == ';')
+            continue;
+
+        if (line.front() == '[') {
+            if (!line.ends_with(']'))
+                return SetError(s("Expected ']' at the end of '", m_Name, "' line ", std::to_string(lineNumber), "."));
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
         }
+
+        const size_t equals = line.find('=');
+        const std::string_view key = trim(line.substr(0, equals));
+        if (equals == std::string_view::npos || key.empty())
+            return SetError(s("Expected 'key = value' at '", m_Name, "' line ", std::to_string(lineNumber), "."));
+
+        std::string_view value = trim(line.substr(equals + 1));
+        if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+            value = value.substr(1, value.size() - 2);
+        m_Entries.push_back({ section, key, value, lineNumber });
     }
 
-    return SetError(s("Expected one of ", GetChoiceString(), " for '", GetParser().GetPrefix(), GetName(), "', got '", val, "'."));
-}
+    // Sections are sorted as a whole, their entries are usually consecutive
+    struct Run
+    {
+        size_t First;
+        size_t Count;
+    };
+    std::vector<Run> runs;
+    for (size_t i = 0; i < m_Entries.size(); ++i) {
+        if (runs.empty() || m_Entries[i].Section != m_Entries[i-1].Section)
+            runs.push_back({ i, 0 });
+        ++runs.back().Count;
+    }
 
-std::string Argue::ChoiceOption::GetChoiceString() const
-{
-    std::string result = "{";
-    for (const auto& choice : m_Choices) {
-        result += choice;
-        result += ',';
+    auto isBefore = [this](const Run& a, const Run& b) { return m_Entries[a.First].Section < m_Entries[b.First].Section; };
+    if (!std::is_sorted(runs.begin(), runs.end(), isBefore)) {
+        std::stable_sort(runs.begin(), runs.end(), isBefore);
+        std::vector<Entry> entries;
+        entries.reserve(m_Entries.size());
+        for (const Run& run : runs)
+            entries.insert(entries.end(), m_Entries.begin() + run.First, m_Entries.begin() + run.First + run.Count);
+        m_Entries = std::move(entries);
     }
-    if (result.back() == ',')
-        result.back() = '}';
-    else result += '}';
-    return result;
+    return true;
 }
 
-bool Argue::CollectionOption::ParseValue(std::string_view val)
+size_t Argue::ConfigFile::FindSection(std::string_view section, size_t& count) const
 {
-    if (!m_AcceptEmptyValues && val.empty()) {
-        return SetError(s(
-            "Empty values are not allowed for '", GetParser().GetPrefix(), GetName(), "'."
-        ));
-    }
-    m_Value.emplace_back(val);
-    return true;
+    auto first = std::lower_bound(m_Entries.begin(), m_Entries.end(), section,
+        [](const Entry& entry, std::string_view name) { return entry.Section < name; });
+    auto last = std::upper_bound(first, m_Entries.end(), section,
+        [](std::string_view name, const Entry& entry) { return name < entry.Section; });
+    count = static_cast<size_t>(last - first);
+    return static_cast<size_t>(first - m_Entries.begin());
 }
 
-bool Argue::StrArgument::ParseArg(std::string_view arg)
+bool Argue::ConfigFile::SetError(std::string&& errorMessage)
 {
-    m_Value = arg;
-    return true;
+    m_Error = std::forward<std::string>(errorMessage);
+    m_Entries.clear();
+    return false;
 }
 
-bool Argue::StrVarArgument::ParseArg(std::string_view arg)
+std::string Argue::FileBinding::GetOrigin(const ConfigFile::Entry& entry) const
 {
-    m_Value.emplace_back(arg);
-    return true;
+    return s("'", m_File.GetName(), "' line ", std::to_string(entry.Line));
 }
 
-void Argue::HelpCommand::operator()(ITextBuilder& help) const
+bool Argue::FileBinding::Resolve(IArgParser& parser)
 {
-    std::string pathUntilLast;
-    std::stack<std::string_view> helpPath;
-    {
-        const auto& rawPath = *m_HelpFor;
-        for (size_t i = rawPath.size(); i > 0; --i)
-            helpPath.emplace(rawPath[i-1]);
-    }
+    size_t count = 0;
+    const size_t first = m_File.FindSection(m_Section, count);
+    if (count == 0)
+        return true;
 
-    const IArgParser* currentSubcommand = &m_Parser;
-    while (!helpPath.empty()) {
-        std::string_view cmdToMatch = helpPath.top();
-        bool hasFoundCommand = false;
-        for (const IArgParser* sub : currentSubcommand->GetSubCommands()) {
-            if (sub->GetName() == cmdToMatch) {
-                hasFoundCommand = true;
-                currentSubcommand = sub;
-                break;
-            }
+    // Options which were parsed before keep their value, e.g. given on the command line
+    const std::vector<IOption*>& options = parser.GetOptions();
+    m_WasParsed.resize(options.size());
+    for (size_t i = 0; i < options.size(); ++i)
+        m_WasParsed[i] = options[i]->WasParsed();
+
+    // Entries are views of the file, nothing is copied unless there is an error
+    const NameTrie& names = parser.GetOptionNames();
+    for (size_t i = first; i < first + count; ++i) {
+        const ConfigFile::Entry& entry = m_File.GetEntries()[i];
+
+        const size_t idx = names.Find(entry.Key);
+        if (idx >= options.size()) {
+            return parser.SetErrorWithSuggestion(
+                s("Unknown option '", entry.Key, "' at ", GetOrigin(entry), "."), names, "", entry.Key);
         }
 
-        if (!hasFoundCommand) {
-            help.PutText(s("Could not find help for '", pathUntilLast, cmdToMatch, "'."));
-            help.NewLine();
-            return;
-        }
+        // Other long names may not take a value, e.g. "no-verbose"
+        IOption& opt = *options[idx];
+        const std::vector<std::string>& aliases = opt.GetAliases();
+        if (entry.Key != opt.GetName() && std::find(aliases.begin(), aliases.end(), entry.Key) == aliases.end())
+            return parser.SetError(s("Expected the name of '", opt.GetName(), "' instead of '", entry.Key, "' at ", GetOrigin(entry), "."));
 
-        helpPath.pop();
-        if (!helpPath.empty()) {
-            pathUntilLast += cmdToMatch;
-            pathUntilLast += " ";
-        }
+        if (!m_WasParsed[idx] && !opt.ParseFallback(entry.Value))
+            return parser.SetError(s(GetOrigin(entry), ": ", parser.GetError()));
     }
-
-    bool briefOptions = false;
-    bool briefSubcommands = *m_PrintType == "brief";
-
-    help.PutText(pathUntilLast);
-    currentSubcommand->WriteHelp(help, briefOptions, briefSubcommands);
+    return true;
 }
 
 #endif // ARGUE_IMPLEMENTATION
@@ -5,4 +5,4 @@ set -xe
 CXX="${CXX:-g++}"
 CXX_FLAGS=`cat cxxflags.txt`
 
-$CXX $CXX_FLAGS -I. -g -o main $1
+$CXX $CXX_FLAGS -I. -g -pthread -o main $1
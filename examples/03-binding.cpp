@@ -0,0 +1,48 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// A plain struct which can be read without going through the options
+struct Config
+{
+    int64_t jobs = 0;
+    bool verbose = false;
+    std::string output;
+};
+
+int main(int argc, const char** argv)
+{
+    Argue::ArgParser parser(argv[0], "Binds options to the fields of a struct.");
+    Argue::IntOption    jobs(parser, "jobs", "j", "N", "Number of jobs. (default: 1)", 1);
+    Argue::FlagOption   verbose(parser, "verbose", "v", "Print more stuff.");
+    Argue::StrOption    output(parser, "output", "o", "FILE", "Output file. (default: out.txt)", "out.txt");
+
+    // Values (or defaults) are written into config once parsing succeeds
+    Config config;
+    Argue::ConfigBinding<Config> binding(parser, config);
+    binding
+        .Bind(&Config::jobs, jobs)
+        .Bind(&Config::verbose, verbose)
+        .Bind(&Config::output, output);
+
+    parser.Parse(argc, argv);
+
+    if (!parser) {
+        // An error happened
+
+        // Build help message and print it
+        Argue::TextBuilder help;
+        parser.WriteHelp(help);
+        std::cout << help.Build() << std::endl;
+
+        // Print error message
+        std::cerr << "ERROR: " << parser.GetError() << std::endl;
+        return 1;
+    }
+
+    std::cout << "jobs: " << config.jobs << std::endl;
+    std::cout << "verbose: " << config.verbose << std::endl;
+    std::cout << "output: " << config.output << std::endl;
+    return 0;
+}
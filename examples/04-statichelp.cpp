@@ -0,0 +1,84 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// The schema is known at compile time, so its help message can be too
+constexpr std::string_view OP_CHOICES[] = {"+", "-", "*", "/"};
+
+constexpr Argue::StaticOption OPTIONS[] = {
+    Argue::StaticOption::Choice("op", "op", "OPERATOR", "The operator to use. (default: +)", OP_CHOICES),
+    Argue::StaticOption::Flag("verbose", "v", "Print the whole expression."),
+};
+
+constexpr Argue::StaticArgument ARGUMENTS[] = {
+    Argue::StaticArgument("A", "The first operand."),
+    Argue::StaticArgument("B", "The second operand."),
+};
+
+constexpr Argue::StaticCommand PROGRAM("math", "Math ain't mathing. 3.0", OPTIONS, ARGUMENTS);
+
+// Rendered by the compiler, then shrunk to its exact size.
+// Compilation fails if the help does not fit within the first capacity.
+constexpr auto HELP_MAX = Argue::RenderStaticHelp<4096>(PROGRAM);
+constexpr Argue::StaticText<HELP_MAX.Size()> HELP = HELP_MAX;
+
+// Narrow enough for every description to wrap
+constexpr auto HELP_NARROW = Argue::RenderStaticHelp<4096>(PROGRAM, false, true, "--", "-", "  ", true, 16);
+
+// The static help is rendered by its own code, so check that it is still the one written by the parser
+static bool IsStaticHelpUpToDate(const Argue::ArgParser& parser)
+{
+    Argue::TextBuilder help;
+    parser.WriteHelp(help);
+    Argue::TextBuilder narrowHelp("  ", true, 16);
+    parser.WriteHelp(narrowHelp);
+    return help.Build() == HELP.View() && narrowHelp.Build() == HELP_NARROW.View();
+}
+
+int main(int argc, const char** argv)
+{
+    // This is the same parser described by PROGRAM
+    Argue::ArgParser parser("math", "Math ain't mathing. 3.0");
+    Argue::ChoiceOption op(
+        parser, "op", "op", "OPERATOR", "The operator to use. (default: +)",
+        {"+", "-", "*", "/"}, 0);
+    Argue::FlagOption verbose(parser, "verbose", "v", "Print the whole expression.");
+    Argue::StrArgument a(parser, "A", "The first operand.");
+    Argue::StrArgument b(parser, "B", "The second operand.");
+
+    if (!IsStaticHelpUpToDate(parser)) {
+        std::cerr << "ERROR: The static help differs from the one of the parser." << std::endl;
+        return 1;
+    }
+
+    // The program name is replaced so that it matches the one in PROGRAM
+    argv[0] = "math";
+    parser.Parse(argc, argv);
+
+    if (!parser) {
+        // An error happened
+
+        // The help message is already built, it only needs to be written
+        std::cout << HELP.View() << std::endl;
+
+        // Print error message
+        std::cerr << "ERROR: " << parser.GetError() << std::endl;
+        return 1;
+    }
+
+    double x = std::stod(*a);
+    double y = std::stod(*b);
+    if (*verbose)
+        std::cout << x << ' ' << *op << ' ' << y << " = ";
+
+    switch ((*op)[0]) {
+    case '+': std::cout << (x + y) << std::endl; break;
+    case '-': std::cout << (x - y) << std::endl; break;
+    case '*': std::cout << (x * y) << std::endl; break;
+    case '/': std::cout << (x / y) << std::endl; break;
+    default: break; // Unreachable if parser succeeded
+    }
+
+    return 0;
+}
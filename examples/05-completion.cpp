@@ -0,0 +1,73 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// Try it out in bash, the generated script never runs the program:
+//   $ source <(./main script --shell=bash)
+// Or let the program answer each request:
+//   $ _main() { COMPREPLY=($(./main __complete "$COMP_CWORD" "${COMP_WORDS[@]}")); }
+//   $ complete -o nospace -F _main ./main
+// Bash splits words on '=', remove it from COMP_WORDBREAKS to complete choices:
+//   $ COMP_WORDBREAKS=${COMP_WORDBREAKS//=}
+int main(int argc, const char** argv)
+{
+    Argue::ArgParser parser(argv[0], "Completes its own options and subcommands.");
+    Argue::FlagOption   verbose(parser, "verbose", "v", "Print more stuff.");
+    Argue::ChoiceOption color(
+        parser, "color", "c", "WHEN", "When to use colors. (default: auto)",
+        {"auto", "always", "never"}, 0);
+
+    Argue::CommandParser install(parser, "install", "Installs packages.");
+    Argue::FlagOption    force(install, "force", "f", "Overwrite installed packages.");
+    Argue::StrVarArgument packages(install, "PACKAGES", "The packages to install.");
+
+    Argue::CommandParser remove(parser, "remove", "Removes packages.");
+    Argue::StrVarArgument toRemove(remove, "PACKAGES", "The packages to remove.");
+
+    Argue::CommandParser script(parser, "script", "Prints the completion script for a shell.");
+    Argue::ChoiceOption  shell(
+        script, "shell", "s", "SHELL", "The shell to complete in. (default: bash)",
+        {"bash", "zsh", "fish"}, 0);
+
+    // The completion command must be checked before parsing,
+    //  completion requests are not valid command lines.
+    // Large trees may answer from their schema image instead, see the schema example:
+    //  Argue::CompletionCommand completion(schema);
+    Argue::CompletionCommand completion(parser);
+    if (completion.Parse(argc, argv)) {
+        for (const std::string& candidate : completion.GetCandidates())
+            std::cout << candidate << '\n';
+        return 0;
+    }
+
+    parser.Parse(argc, argv);
+
+    if (!parser) {
+        // An error happened
+
+        // Build help message and print it
+        Argue::TextBuilder help;
+        parser.WriteHelp(help);
+        std::cout << help.Build() << std::endl;
+
+        // Print error message
+        std::cerr << "ERROR: " << parser.GetError() << std::endl;
+        return 1;
+    }
+
+    if (install) {
+        for (const std::string& package : *packages)
+            std::cout << "Installing " << package << (*force ? " (forced)" : "") << std::endl;
+    } else if (remove) {
+        for (const std::string& package : *toRemove)
+            std::cout << "Removing " << package << std::endl;
+    } else if (script) {
+        Argue::CompletionShell completionShell =
+            *shell == "zsh"  ? Argue::CompletionShell::Zsh  :
+            *shell == "fish" ? Argue::CompletionShell::Fish :
+            Argue::CompletionShell::Bash;
+        std::cout << Argue::GenerateCompletionScript(parser, "./main", completionShell);
+    }
+    return 0;
+}
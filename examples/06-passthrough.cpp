@@ -0,0 +1,56 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// Everything this wrapper doesn't know is forwarded to the command it wraps:
+//   $ ./main --times=2 -v make -j8 all
+// Prefixes which may name more than one option are forwarded too:
+//   $ ./main --ver make  # runs "--ver make"
+int main(int argc, const char** argv)
+{
+    Argue::ArgParser parser(argv[0], "Runs a command a few times.");
+    Argue::IntOption  times(parser, "times", "n", "N", "How many times to run the command. (default: 1)", 1);
+    Argue::FlagOption verbose(parser, "verbose", "v", "Print the number of each run.");
+    Argue::FlagOption version(parser, "version", "", "Print the version of the wrapper.");
+
+    // Unknown arguments are not copied, they are views of argv
+    std::vector<std::string_view> command;
+    parser.SetPassThrough(&command);
+    parser.Parse(argc, argv);
+
+    if (parser && *version) {
+        std::cout << "0.1.0" << std::endl;
+        return 0;
+    }
+
+    if (!parser || command.empty()) {
+        // An error happened
+
+        // Build help message and print it
+        Argue::TextBuilder help;
+        parser.WriteHelp(help);
+        std::cout << help.Build() << std::endl;
+
+        // Print error message
+        std::cerr << "ERROR: " << (parser ? "Missing command to run." : parser.GetError()) << std::endl;
+        return 1;
+    }
+
+    // Each view's data() is a null-terminated argument,
+    //  an argv for execv() can be built without copying them.
+    std::vector<const char*> childArgv;
+    for (std::string_view arg : command)
+        childArgv.push_back(arg.data());
+    childArgv.push_back(nullptr);
+
+    // A real wrapper would fork and execv() here
+    for (int64_t i = 0; i < *times; ++i) {
+        if (*verbose)
+            std::cout << "Run " << (i+1) << '/' << *times << ": ";
+        for (size_t j = 0; childArgv[j] != nullptr; ++j)
+            std::cout << (j > 0 ? " " : "") << childArgv[j];
+        std::cout << std::endl;
+    }
+    return 0;
+}
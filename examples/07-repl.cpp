@@ -0,0 +1,44 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// Reads commands from the standard input, e.g.:
+//   > greet --name="John Doe" -n3
+//   > quit
+int main()
+{
+    Argue::ArgParser parser("repl", "Greets people until it quits.");
+    Argue::CommandParser greet(parser, "greet", "Greets someone.");
+    Argue::StrOption     name(greet, "name", "N", "NAME", "Who to greet. (default: World)", "World");
+    Argue::IntOption     times(greet, "times", "n", "N", "How many times to greet. (default: 1)", 1);
+    Argue::CommandParser quit(parser, "quit", "Quits.");
+
+    // The same parser parses each line, only the words which changed since the previous line are parsed.
+    // e.g. this would also keep hints up to date on each key press without re-parsing the whole line.
+    Argue::IncrementalParser incremental(parser);
+
+    Argue::Tokenizer tokenizer;
+    std::vector<std::string_view> words;
+    std::string line;
+    while (std::cout << "> " << std::flush, std::getline(std::cin, line)) {
+        // Words are views of `line` unless they were unescaped
+        words.clear();
+        words.push_back("repl");
+        if (!tokenizer.Tokenize(line, words)) {
+            std::cerr << "ERROR: Unterminated quote or escape." << std::endl;
+            continue;
+        }
+
+        if (!incremental.Parse(words)) {
+            std::cerr << "ERROR: " << parser.GetError() << std::endl;
+            continue;
+        }
+
+        if (quit)
+            break;
+        for (int64_t i = 0; greet && i < *times; ++i)
+            std::cout << "Hello " << *name << "!" << std::endl;
+    }
+    return 0;
+}
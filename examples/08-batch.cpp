@@ -0,0 +1,54 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// Each thread builds its own parser tree
+class PackageManager final :
+    public Argue::IBatchWorker
+{
+public:
+    Argue::ArgParser& GetParser() override { return m_Parser; }
+
+private:
+    Argue::ArgParser      m_Parser{"pkg", "Manages packages."};
+    Argue::FlagOption     m_Verbose{m_Parser, "verbose", "v", "Print more stuff."};
+    Argue::CommandParser  m_Install{m_Parser, "install", "Installs packages."};
+    Argue::FlagOption     m_Force{m_Install, "force", "f", "Overwrite installed packages."};
+    Argue::StrVarArgument m_Packages{m_Install, "PACKAGES", "The packages to install."};
+    Argue::CommandParser  m_Remove{m_Parser, "remove", "Removes packages."};
+    Argue::StrVarArgument m_ToRemove{m_Remove, "PACKAGES", "The packages to remove."};
+};
+
+// Checks logged command lines against the current options, e.g.:
+//   $ printf '%s\n' '/bin/pkg install -f vim' 'pkg uninstall vim' | ./main
+int main()
+{
+    // Words are copied, the tokenizer reuses its arena for each line
+    std::vector<std::vector<std::string>> loggedLines;
+    Argue::Tokenizer tokenizer;
+    std::vector<std::string_view> words;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        words.clear();
+        if (tokenizer.Tokenize(line, words))
+            loggedLines.emplace_back(words.begin(), words.end());
+    }
+
+    std::vector<std::vector<std::string_view>> commandLines;
+    for (const std::vector<std::string>& loggedLine : loggedLines)
+        commandLines.emplace_back(loggedLine.begin(), loggedLine.end());
+
+    std::vector<Argue::BatchResult> results = Argue::ParseBatch(
+        commandLines, []() { return std::make_unique<PackageManager>(); });
+
+    int invalidCount = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].IsValid)
+            continue;
+        ++invalidCount;
+        std::cerr << "Line " << (i+1) << ", word " << results[i].ErrorWordIdx
+                  << ": " << results[i].Error << std::endl;
+    }
+    return invalidCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef ARGUE_POSIX
+#include <sys/stat.h> // lstat mkdir
+#include <unistd.h>   // getuid
+#endif
+
+// The server and its clients must agree on the schema, its fingerprint includes the program's name
+static constexpr std::string_view NAME = "main";
+
+// The parser tree is built by the server once, clients only read its results
+struct Compiler
+{
+    Compiler(std::string_view name) :
+        parser(name, "Compiles sources.")
+    {}
+
+    Argue::ArgParser        parser;
+    Argue::FlagOption       compileOnly{parser, "compile", "c", "Compile without linking."};
+    Argue::StrOption        output{parser, "output", "o", "FILE", "Where to write the output. (default: a.out)", "a.out"};
+    Argue::IntOption        level{parser, "optimize", "O", "LEVEL", "The optimization level. (default: 0)", 0};
+    Argue::CollectionOption defines{parser, "define", "D", "MACRO", "Define a macro."};
+    Argue::StrVarArgument   sources{parser, "SOURCES", "The files to compile."};
+};
+
+#ifdef ARGUE_POSIX
+static Argue::ParseServer* server = nullptr;
+
+// Other users must not be able to replace the socket, it lives in a directory only we can write to
+static std::string GetSocketPath()
+{
+    if (const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR"); runtimeDir && *runtimeDir)
+        return std::string(runtimeDir) + "/argue-example.sock";
+
+    const std::string dir = "/tmp/argue-example-" + std::to_string(getuid());
+    mkdir(dir.c_str(), 0700);
+    struct stat status;
+    if (lstat(dir.c_str(), &status) != 0 || !S_ISDIR(status.st_mode) ||
+        status.st_uid != getuid() || (status.st_mode & 077) != 0)
+        return {};
+    return dir + "/argue-example.sock";
+}
+
+static void StopServer(int)
+{
+    server->Stop();
+}
+#endif
+
+// Start the server once:
+//   $ ./main --serve &
+// Then each run asks it to parse, or parses on its own if it's not running:
+//   $ ./main -O2 -DNDEBUG -c -omain.o main.c
+int main(int argc, const char** argv)
+{
+#ifdef ARGUE_POSIX
+    const std::string socketPath = GetSocketPath();
+
+    if (argc == 2 && std::string_view(argv[1]) == "--serve") {
+        if (socketPath.empty()) {
+            std::cerr << "ERROR: No private directory for the socket." << std::endl;
+            return 1;
+        }
+        Compiler compiler(NAME);
+        Argue::ParseServer parseServer(compiler.parser);
+        if (!parseServer.Listen(socketPath)) {
+            std::cerr << "ERROR: " << parseServer.GetError() << std::endl;
+            return 1;
+        }
+
+        server = &parseServer;
+        std::signal(SIGINT, StopServer);
+        std::signal(SIGTERM, StopServer);
+        if (!parseServer.Serve()) {
+            std::cerr << "ERROR: " << parseServer.GetError() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Real clients embed the FINGERPRINT of their generated schema source instead,
+    //  see the codegen example, so that they don't build the tree to ask the server
+    const uint64_t fingerprint = Argue::FingerprintSchema(Argue::EncodeSchema(Compiler(NAME).parser));
+
+    Argue::ParseResult result;
+    if (socketPath.empty() || !Argue::RequestParse(socketPath, fingerprint, argc, argv, result)) {
+        // Results are encoded the same way when parsing locally
+        Compiler compiler(NAME);
+        compiler.parser.Parse(argc, argv);
+        result.Assign(Argue::EncodeParseResult(compiler.parser));
+    }
+
+    if (!result.IsValid()) {
+        std::cerr << "ERROR: " << result.GetError() << std::endl;
+        return 1;
+    }
+
+    std::cout << (result.GetBool("compile") ? "Compiling" : "Building") << " with -O" << result.GetInt("optimize");
+    // Values are read in place, without copying them out of the result
+    const size_t defines = result.FindId("define");
+    for (size_t i = 0; i < result.GetStringCount(defines); ++i)
+        std::cout << " -D" << result.GetStringAt(defines, i);
+    std::cout << ':';
+    const size_t sources = result.FindId("SOURCES");
+    for (size_t i = 0; i < result.GetStringCount(sources); ++i)
+        std::cout << ' ' << result.GetStringAt(sources, i);
+    std::cout << " -> " << result.GetString("output") << std::endl;
+    return 0;
+#else
+    (void)argc;
+    (void)argv;
+    std::cerr << "ERROR: Parse servers need Unix domain sockets." << std::endl;
+    return 1;
+#endif
+}
@@ -0,0 +1,90 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+static volatile std::sig_atomic_t isReloadRequested = 1;
+static volatile std::sig_atomic_t isStopRequested = 0;
+
+// Reloads its options from a file each time it receives SIGHUP:
+//   $ echo '--greeting=Hi --interval=500' > greeter.args
+//   $ ./main greeter.args &
+//   $ echo '--greeting=Hello' > greeter.args && kill -HUP %1
+int main(int argc, const char** argv)
+{
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " FILE" << std::endl;
+        return 1;
+    }
+
+    Argue::ArgParser parser(argv[0], "Greets periodically.");
+    Argue::StrOption greeting(parser, "greeting", "g", "TEXT", "How to greet. (default: Hello)", "Hello");
+    Argue::IntOption interval(parser, "interval", "i", "MS", "How often to greet. (default: 1000)", 1000);
+
+    Argue::LiveConfig config(parser);
+
+    // Workers never see options while they are parsed, only the published values
+    std::atomic<bool> isStopped = false;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 2; ++i) {
+        workers.emplace_back([&config, &isStopped, i]() {
+            // The config has room for 64 readers by default
+            std::unique_ptr<Argue::LiveConfig::Reader> reader = config.AddReader();
+            if (!reader) {
+                std::cerr << "ERROR: Too many readers." << std::endl;
+                return;
+            }
+
+            while (!isStopped) {
+                int64_t intervalMs = 1000;
+                {
+                    Argue::LiveConfig::Snapshot snapshot = reader->Read();
+                    if (snapshot.GetGeneration() > 0) {
+                        std::ostringstream line;
+                        line << "Worker " << i << ": " << snapshot->GetString("greeting") << "!\n";
+                        std::cout << line.str() << std::flush;
+                        intervalMs = snapshot->GetInt("interval", intervalMs);
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            }
+        });
+    }
+
+#ifdef SIGHUP
+    std::signal(SIGHUP, [](int) { isReloadRequested = 1; });
+#endif
+    std::signal(SIGINT, [](int) { isStopRequested = 1; });
+
+    Argue::Tokenizer tokenizer;
+    std::vector<std::string_view> args;
+    while (!isStopRequested) {
+        if (isReloadRequested) {
+            isReloadRequested = 0;
+
+            std::ifstream file(argv[1]);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            // Words may be views of the contents
+            const std::string contents = stream.str();
+
+            // An invalid file keeps the previous options
+            args.clear();
+            if (!tokenizer.Tokenize(contents, args))
+                std::cerr << "ERROR: Unterminated quote or escape." << std::endl;
+            else if (!config.Reload(args))
+                std::cerr << "ERROR: " << config.GetError() << std::endl;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    isStopped = true;
+    for (std::thread& worker : workers)
+        worker.join();
+    return 0;
+}
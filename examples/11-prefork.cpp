@@ -0,0 +1,54 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+#ifdef ARGUE_POSIX
+  #include <sys/wait.h>
+#endif
+
+// Parses its options once, then forks workers which all read them from the same pages:
+//   $ ./main --workers=4 --root=/srv/www
+int main(int argc, const char** argv)
+{
+#ifdef ARGUE_POSIX
+    Argue::SharedResult shared;
+    {
+        // The parser tree is freed before forking, workers only read the shared result
+        Argue::ArgParser parser(argv[0], "Serves files with a few workers.");
+        Argue::IntOption workers(parser, "workers", "w", "N", "How many workers to run. (default: 2)", 2);
+        Argue::StrOption root(parser, "root", "r", "DIR", "The directory to serve. (default: .)", ".");
+        parser.Parse(argc, argv);
+
+        if (!parser) {
+            Argue::TextBuilder help;
+            parser.WriteHelp(help);
+            std::cout << help.Build() << std::endl;
+            std::cerr << "ERROR: " << parser.GetError() << std::endl;
+            return 1;
+        }
+
+        if (!shared.Publish(Argue::EncodeParseResult(parser))) {
+            std::cerr << "ERROR: " << shared.GetError() << std::endl;
+            return 1;
+        }
+    }
+
+    const int64_t workerCount = shared->GetInt("workers");
+    for (int64_t i = 0; i < workerCount; ++i) {
+        if (fork() == 0) {
+            // An exec'd worker would be given shared.GetFd() and call Map() instead
+            std::cout << "Worker " << i << " serving " << shared->GetString("root") << std::endl;
+            return 0;
+        }
+    }
+
+    while (wait(nullptr) > 0) {}
+    return 0;
+#else
+    (void)argc;
+    (void)argv;
+    std::cerr << "ERROR: Shared results need POSIX shared memory." << std::endl;
+    return 1;
+#endif
+}
@@ -0,0 +1,61 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <fstream>
+#include <iostream>
+
+// The parser tree is only built when its schema image is not cached yet
+static std::string BuildSchema()
+{
+    Argue::ArgParser parser("convert", "Converts images.");
+    Argue::ChoiceOption format(
+        parser, "format", "f", "FORMAT", "The format to convert to. (default: png)",
+        {"png", "jpeg", "webp"}, 0);
+    Argue::IntOption quality(parser, "quality", "q", "PERCENT", "The quality of lossy formats. (default: 90)", 90);
+    Argue::FlagOption verbose(parser, "verbose", "v", "Print each converted image.");
+    Argue::StrVarArgument images(parser, "IMAGES", "The images to convert.");
+    return Argue::EncodeSchema(parser);
+}
+
+// The first run caches the schema image next to the program, the next ones map it:
+//   $ ./main -fwebp -q80 -v photo.jpg
+// The image would usually be generated at build time, the cache must be removed when the options change.
+int main(int argc, const char** argv)
+{
+#ifdef ARGUE_POSIX
+    const std::string cachePath = std::string(argv[0]) + ".schema";
+
+    Argue::MappedFile file;
+    Argue::SchemaView schema;
+    std::string image;
+    // An image from another version of Argue is not attached, it's then replaced
+    if (!file.Open(cachePath) || !schema.Attach(file.GetData())) {
+        image = BuildSchema();
+        std::ofstream(cachePath, std::ios::binary) << image;
+        schema.Attach(image);
+    }
+
+    Argue::ParseResult result;
+    if (!schema.Parse(argc, argv, result)) {
+        Argue::TextBuilder help;
+        schema.WriteHelp(help);
+        std::cout << help.Build() << std::endl;
+        std::cerr << "ERROR: " << result.GetError() << std::endl;
+        return 1;
+    }
+
+    const size_t images = result.FindId("IMAGES");
+    for (size_t i = 0; i < result.GetStringCount(images); ++i) {
+        if (result.GetBool("verbose"))
+            std::cout << "Converting " << result.GetStringAt(images, i) << std::endl;
+    }
+    std::cout << "Converted " << result.GetStringCount(images) << " images to " << result.GetString("format")
+              << " (quality " << result.GetInt("quality") << "%)." << std::endl;
+    return 0;
+#else
+    (void)argc;
+    (void)argv;
+    std::cerr << "ERROR: Mapped schema images need POSIX mmap." << std::endl;
+    return 1;
+#endif
+}
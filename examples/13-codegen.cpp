@@ -0,0 +1,52 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <fstream>
+#include <iostream>
+
+// Generates the source of a parser from a schema image, e.g. the one cached by the schema example:
+//   $ ./main --output=convert_cli.hpp main.schema convert_cli
+// A program which includes the generated file neither builds the parser tree nor maps the image:
+//   convert_cli::Values values;
+//   Argue::ParseResult result;
+//   if (!convert_cli::Parse(argc, argv, result, values)) {
+//       std::cout << convert_cli::HELP << std::endl;
+//       std::cerr << "ERROR: " << result.GetError() << std::endl;
+//       return 1;
+//   }
+//   std::cout << "Converting to " << values.format << " at " << values.quality << "%" << std::endl;
+int main(int argc, const char** argv)
+{
+    Argue::ArgParser parser(argv[0], "Generates C++ source which parses with a schema image.");
+    Argue::StrOption output(parser, "output", "o", "PATH", "Where to write the source. (default: stdout)", "");
+    Argue::StrArgument schemaPath(parser, "SCHEMA", "The schema image, see Argue::EncodeSchema().");
+    Argue::StrArgument ns(parser, "NAMESPACE", "The namespace of the generated definitions.");
+
+    parser.Parse(argc, argv);
+
+    if (!parser) {
+        Argue::TextBuilder help;
+        parser.WriteHelp(help);
+        std::cout << help.Build() << std::endl;
+        std::cerr << "ERROR: " << parser.GetError() << std::endl;
+        return 1;
+    }
+
+    std::ifstream file(*schemaPath, std::ios::binary);
+    const std::string image{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    Argue::SchemaView schema;
+    if (!file || !schema.Attach(image)) {
+        std::cerr << "ERROR: '" << *schemaPath << "' is not a schema image of this version of Argue." << std::endl;
+        return 1;
+    }
+
+    const std::string source = Argue::GenerateSchemaSource(schema, *ns);
+    if (*output == "") {
+        std::cout << source;
+    } else if (!(std::ofstream(*output, std::ios::binary) << source)) {
+        std::cerr << "ERROR: Could not write '" << *output << "'." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// Options which are not given fall back to environment variables, then to their default:
+//   $ export APP_TOKEN=secret
+//   $ APP_JOBS=8 APP_VERBOSE=true ./main
+//   $ APP_JOBS=8 ./main --jobs=2
+//   $ APP_FORCE=1 ./main install pkg
+int main(int argc, const char** argv)
+{
+    Argue::ArgParser parser(argv[0], "Reads its options from the environment.");
+    Argue::IntOption  jobs(parser, "jobs", "j", "N", "Number of jobs, APP_JOBS. (default: 1)", 1);
+    Argue::FlagOption verbose(parser, "verbose", "v", "Print more stuff, APP_VERBOSE.");
+    Argue::StrOption  token(parser, "token", "t", "TOKEN", "The token to authenticate with, APP_TOKEN.");
+
+    Argue::CommandParser  install(parser, "install", "Installs packages.");
+    Argue::FlagOption     force(install, "force", "f", "Overwrite installed packages, APP_FORCE.");
+    Argue::StrVarArgument packages(install, "PACKAGES", "The packages to install.");
+
+    // Variables are indexed once, each binding then looks its own up
+    Argue::Environment env;
+    Argue::EnvBinding  envBinding(parser, env);
+    envBinding
+        .Bind(jobs, "APP_JOBS")
+        .Bind(verbose, "APP_VERBOSE")
+        .Bind(token, "APP_TOKEN");
+
+    // Options of a subcommand are bound within it, all of them at once here
+    Argue::EnvBinding installEnv(install, env);
+    installEnv.BindAll("APP_");
+
+    parser.Parse(argc, argv);
+
+    if (!parser) {
+        // An error happened, e.g. APP_TOKEN is not set nor --token given
+
+        // Build help message and print it
+        Argue::TextBuilder help;
+        parser.WriteHelp(help);
+        std::cout << help.Build() << std::endl;
+
+        // Print error message
+        std::cerr << "ERROR: " << parser.GetError() << std::endl;
+        return 1;
+    }
+
+    std::cout << "jobs: " << *jobs << (jobs.IsFallback() ? " (from APP_JOBS)" : "") << std::endl;
+    std::cout << "verbose: " << *verbose << std::endl;
+    std::cout << "token: " << token.GetValue().size() << " characters" << std::endl;
+    if (install) {
+        for (const std::string& package : *packages)
+            std::cout << "Installing " << package << (*force ? " (forced)" : "") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#define ARGUE_IMPLEMENTATION
+#include "argue.hpp"
+
+#include <iostream>
+
+// Options which are not given are read from a configuration file, if there is one:
+//   $ printf 'jobs = 4\n\n[install]\nforce = true\n' > main.conf
+//   $ ./main install pkg
+//   $ ./main --jobs=2 install --no-force pkg
+int main(int argc, const char** argv)
+{
+    Argue::ArgParser parser(argv[0], "Reads its options from main.conf.");
+    Argue::IntOption  jobs(parser, "jobs", "j", "N", "Number of jobs. (default: 1)", 1);
+    Argue::StrOption  output(parser, "output", "o", "DIR", "Where to write logs. (default: logs)", "logs");
+
+    Argue::CommandParser  install(parser, "install", "Installs packages.");
+    Argue::FlagOption     force(install, "force", "f", "Overwrite installed packages.");
+    Argue::StrVarArgument packages(install, "PACKAGES", "The packages to install.");
+
+    // Each command reads its own section, only once it was used
+    Argue::ConfigFile   config;
+    Argue::FileBinding  rootConfig(parser, config);
+    Argue::FileBinding  installConfig(install, config, "install");
+
+    if (!config.Open("main.conf"))
+        std::cerr << "WARNING: " << config.GetError() << std::endl;
+
+    parser.Parse(argc, argv);
+
+    if (!parser) {
+        // An error happened, e.g. a key of main.conf is not an option
+
+        // Build help message and print it
+        Argue::TextBuilder help;
+        parser.WriteHelp(help);
+        std::cout << help.Build() << std::endl;
+
+        // Print error message
+        std::cerr << "ERROR: " << parser.GetError() << std::endl;
+        return 1;
+    }
+
+    std::cout << "jobs: " << *jobs << (jobs.IsFallback() ? " (from main.conf)" : "") << std::endl;
+    std::cout << "output: " << *output << std::endl;
+    if (install) {
+        for (const std::string& package : *packages)
+            std::cout << "Installing " << package << (*force ? " (forced)" : "") << std::endl;
+    }
+    return 0;
+}